@@ -0,0 +1,152 @@
+//
+//  Dictionary index test
+//
+//  Checks DictionaryIndex::identify against cv::aruco::Dictionary::identify on DICT_4X4_1000 .. DICT_7X7_1000
+//  for exact codes, codes with correctable errors and random (mostly unknown) ones, ids and rotations must be
+//  the same, then times both. DictionaryIndex::decode is checked on drawn markers in every rotation.
+//  Returns non-zero if anything differs
+//
+
+#include "aruco_DictionaryIndex.h"
+
+static double milliseconds(int64 ticks)
+{
+	return ticks * 1000.0 / cv::getTickFrequency();
+}
+
+/// <summary>
+/// Inverse of DictionaryIndex::pack
+/// </summary>
+static cv::Mat unpack(uint64 code, int markerSize)
+{
+	cv::Mat bits(markerSize, markerSize, CV_8UC1);
+	for (int k = 0; k < markerSize * markerSize; ++k)
+		bits.at<uchar>(k / markerSize, k % markerSize) = (uchar)((code >> k) & 1);
+	return bits;
+}
+
+/// <summary>
+/// Draws every rotation of a few markers and decodes them from their exact outline
+/// </summary>
+static int checkDecode(const cv::Ptr<cv::aruco::Dictionary> &dictionary, DictionaryIndex &index, cv::RNG &rng)
+{
+	cv::Ptr<cv::aruco::DetectorParameters> params = cv::aruco::DetectorParameters::create();
+	const int side = (dictionary->markerSize + 2 * params->markerBorderBits) * 10, margin = side / 2;
+
+	int failures = 0;
+	for (int n = 0; n < 16; ++n)
+	{
+		const int id = rng.uniform(0, dictionary->bytesList.rows);
+		cv::Mat marker;
+		cv::aruco::drawMarker(dictionary, id, side, marker, params->markerBorderBits);
+
+		for (int r = 0; r < 4; ++r)
+		{
+			cv::Mat image(side + 2 * margin, side + 2 * margin, CV_8UC1, cv::Scalar::all(255));
+			marker.copyTo(image(cv::Rect(margin, margin, side, side)));
+
+			std::vector<cv::Point2f> corners;
+			corners.push_back(cv::Point2f((float)margin, (float)margin));
+			corners.push_back(cv::Point2f((float)(margin + side), (float)margin));
+			corners.push_back(cv::Point2f((float)(margin + side), (float)(margin + side)));
+			corners.push_back(cv::Point2f((float)margin, (float)(margin + side)));
+
+			int decoded = -1;
+			if (!index.decode(image, corners, *params, decoded) || decoded != id)
+			{
+				++failures;
+				printf("DECODE MISMATCH: marker %d, rotation %d, decoded %d\n", id, r, decoded);
+			}
+
+			// 90 degrees clockwise
+			cv::transpose(marker, marker);
+			cv::flip(marker, marker, 1);
+		}
+	}
+	return failures;
+}
+
+int main(int argc, char **argv)
+{
+	const int names[] = { cv::aruco::DICT_4X4_1000, cv::aruco::DICT_5X5_1000, cv::aruco::DICT_6X6_1000, cv::aruco::DICT_7X7_1000 };
+	const char *titles[] = { "4X4_1000", "5X5_1000", "6X6_1000", "7X7_1000" };
+	const int samples = (argc > 1) ? std::max(1, atoi(argv[1])) : 2000;
+	const double correctionRate = 0.6;
+
+	cv::RNG rng(0x5eed);
+	int failures = 0;
+
+	printf("%-10s %-8s %8s %14s %14s %8s\n", "dict", "codes", "matched", "aruco, us", "index, us", "speedup");
+	for (size_t d = 0; d < sizeof(names) / sizeof(names[0]); ++d)
+	{
+		cv::Ptr<cv::aruco::Dictionary> dictionary = cv::aruco::getPredefinedDictionary(names[d]);
+		DictionaryIndex index(*dictionary);
+		const int bitsCount = dictionary->markerSize * dictionary->markerSize;
+		const int maxCorrection = int(dictionary->maxCorrectionBits * correctionRate);
+
+		// exact codes, codes with correctable errors, random codes (the full scan, the usual rejected candidate)
+		for (int kind = 0; kind < 3; ++kind)
+		{
+			std::vector<uint64> codes(samples);
+			std::vector<cv::Mat> bits(samples);
+			for (int i = 0; i < samples; ++i)
+			{
+				uint64 code = 0;
+				if (kind < 2)
+				{
+					cv::Mat rotated(1, dictionary->bytesList.cols, CV_8UC4, cv::Scalar::all(0));
+					int m = rng.uniform(0, dictionary->bytesList.rows), r = rng.uniform(0, 4);
+					memcpy(rotated.ptr(), dictionary->bytesList.ptr(m) + r * dictionary->bytesList.cols, dictionary->bytesList.cols);
+					code = index.pack(cv::aruco::Dictionary::getBitsFromByteList(rotated, dictionary->markerSize));
+					for (int e = (kind == 1) ? rng.uniform(1, std::max(2, maxCorrection + 1)) : 0; e > 0; --e)
+						code ^= (uint64)1 << rng.uniform(0, bitsCount);
+				}
+				else
+				{
+					code = (((uint64)(unsigned)rng.next() << 32) | (unsigned)rng.next()) & ((bitsCount == 64) ? ~(uint64)0 : (((uint64)1 << bitsCount) - 1));
+				}
+				codes[i] = code;
+				bits[i] = unpack(code, dictionary->markerSize);
+			}
+
+			// #0 equality
+			int matched = 0;
+			for (int i = 0; i < samples; ++i)
+			{
+				int expectedIdx = -1, expectedRotation = -1, idx = -1, rotation = -1;
+				bool expected = dictionary->identify(bits[i], expectedIdx, expectedRotation, correctionRate);
+				bool actual = index.identify(codes[i], correctionRate, idx, rotation);
+				if (expected != actual || (expected && (expectedIdx != idx || expectedRotation != rotation)))
+				{
+					++failures;
+					printf("MISMATCH: %s, code %llx: aruco %d (%d, %d), index %d (%d, %d)\n", titles[d], (unsigned long long)codes[i],
+						expected, expectedIdx, expectedRotation, actual, idx, rotation);
+				}
+				matched += expected ? 1 : 0;
+			}
+
+			// #1 timing, aruco gets the bits matrix as detectMarkers hands it over, the index gets the packed code
+			int idx, rotation;
+			int64 started = cv::getTickCount();
+			for (int i = 0; i < samples; ++i)
+				dictionary->identify(bits[i], idx, rotation, correctionRate);
+			double reference = milliseconds(cv::getTickCount() - started) * 1000.0 / samples;
+
+			started = cv::getTickCount();
+			for (int i = 0; i < samples; ++i)
+				index.identify(codes[i], correctionRate, idx, rotation);
+			double packed = milliseconds(cv::getTickCount() - started) * 1000.0 / samples;
+
+			const char *kinds[] = { "exact", "errors", "random" };
+			printf("%-10s %-8s %8d %14.3f %14.3f %7.2fx\n", titles[d], kinds[kind], matched, reference, packed, reference / std::max(packed, 1e-9));
+		}
+
+		failures += checkDecode(dictionary, index, rng);
+	}
+
+	if (failures)
+		printf("%d check(s) differ from aruco\n", failures);
+	else
+		printf("all results match aruco\n");
+	return failures ? 1 : 0;
+}
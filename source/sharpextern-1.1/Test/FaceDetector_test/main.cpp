@@ -0,0 +1,69 @@
+//
+//  Face detector test
+//
+//  Finds the largest face of the given photo, shrinks the photo so that face is ~50 pixels wide (below the
+//  80x80 detection window) and checks FaceDetector with default parameters finds it with upsample = 1,
+//  results without upsampling are printed for comparison. Returns non-zero if the small face is not found
+//
+
+#include "dlib.h"
+
+static int largest(const std::vector<dlib_FaceDetection> &faces)
+{
+	int best = -1;
+	for (size_t i = 0; i < faces.size(); ++i)
+	{
+		if (best < 0 || faces[i].rect.width > faces[best].rect.width)
+			best = (int)i;
+	}
+	return best;
+}
+
+int main(int argc, char **argv)
+{
+	if (argc < 2)
+	{
+		printf("usage: main <photo with a face>\n");
+		return 1;
+	}
+
+	cv::Mat photo = cv::imread(argv[1], cv::IMREAD_GRAYSCALE);
+	if (photo.empty())
+	{
+		printf("can't read %s\n", argv[1]);
+		return 1;
+	}
+
+	FaceDetector detector(0);
+
+	// #0 reference face at the original size
+	const std::vector<dlib_FaceDetection> &reference = detector.detect(photo);
+	int found = largest(reference);
+	if (found < 0)
+	{
+		printf("no reference face in %s\n", argv[1]);
+		return 1;
+	}
+	const double size = reference[found].rect.width;
+
+	// #1 the same photo with a ~50 pixels face
+	const double target = 50.0;
+	cv::Mat small;
+	cv::resize(photo, small, cv::Size(), target / size, target / size, cv::INTER_AREA);
+
+	detector.upsample = 0;
+	int plain = (int)detector.detect(small).size();
+
+	detector.upsample = 1;
+	const std::vector<dlib_FaceDetection> &faces = detector.detect(small);
+	found = largest(faces);
+
+	printf("reference face %.0f px, image %dx%d: upsample 0 finds %d face(s), upsample 1 finds %d", size, small.cols, small.rows, plain, (int)faces.size());
+	if (found >= 0)
+		printf(", the largest is %d px", faces[found].rect.width);
+	printf("\n");
+
+	bool ok = found >= 0 && faces[found].rect.width < 80;
+	printf(ok ? "small face is found with upsample 1\n" : "FAILED: small face is not found with upsample 1\n");
+	return ok ? 0 : 1;
+}
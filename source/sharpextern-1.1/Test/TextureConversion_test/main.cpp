@@ -0,0 +1,98 @@
+//
+//  Texture conversion test
+//
+//  Checks utils_rgba_to_bgr (single-pass conversion, rotation and flips) against the original three-pass
+//  cvtColor + t() + flip path for every rotation angle and flip combination, output must be bit-exact,
+//  then times both paths. Returns non-zero if any combination differs
+//
+
+#include "utils.h"
+
+/// <summary>
+/// The original utils_texture_to_mat path
+/// </summary>
+static void reference_rgba_to_bgr(const cv::Mat &input, bool flipVertically, bool flipHorizontally, int rotationAngle, cv::Mat &output)
+{
+	cv::Mat bgr;
+	cv::cvtColor(input, bgr, CV_RGBA2BGR);
+
+	if (utils_resolve_rotation(rotationAngle, flipVertically, flipHorizontally))
+		bgr = bgr.t();
+
+	if (flipVertically || flipHorizontally)
+	{
+		int flipCode = (flipVertically && flipHorizontally) ? -1 : (flipVertically ? 0 : 1);
+		cv::flip(bgr, output, flipCode);
+	}
+	else
+	{
+		output = bgr;
+	}
+}
+
+static double milliseconds(int64 ticks)
+{
+	return ticks * 1000.0 / cv::getTickFrequency();
+}
+
+int main(int argc, char **argv)
+{
+	const int angles[] = { -270, -180, -90, 0, 90, 180, 270 };
+	const int iterations = (argc > 1) ? std::max(1, atoi(argv[1])) : 50;
+
+	// odd sizes cover the SIMD tails and partial tiles, 720p is the usual camera frame
+	const cv::Size sizes[] = { cv::Size(37, 23), cv::Size(641, 479), cv::Size(1280, 720) };
+
+	cv::RNG rng(0x5eed);
+	int failures = 0;
+
+	printf("%-10s %6s %6s %6s %12s %12s %8s\n", "size", "angle", "flipV", "flipH", "3-pass, ms", "1-pass, ms", "speedup");
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+	{
+		cv::Mat input(sizes[s], CV_8UC4);
+		rng.fill(input, cv::RNG::UNIFORM, 0, 256);
+
+		for (size_t a = 0; a < sizeof(angles) / sizeof(angles[0]); ++a)
+		{
+			for (int flags = 0; flags < 4; ++flags)
+			{
+				const bool flipVertically = 0 != (flags & 1), flipHorizontally = 0 != (flags & 2);
+
+				// #0 equality
+				cv::Mat expected, actual;
+				reference_rgba_to_bgr(input, flipVertically, flipHorizontally, angles[a], expected);
+				utils_rgba_to_bgr(input, flipVertically, flipHorizontally, angles[a], actual);
+
+				bool equal = expected.size() == actual.size() && expected.type() == actual.type() && 0 == cv::norm(expected, actual, cv::NORM_INF);
+				if (!equal)
+				{
+					++failures;
+					printf("MISMATCH: %dx%d, angle %d, flipV %d, flipH %d\n", input.cols, input.rows, angles[a], flipVertically, flipHorizontally);
+				}
+
+				// #1 timing, new path re-uses its output the way utils_texture_to_mat_into callers do
+				int64 started = cv::getTickCount();
+				for (int i = 0; i < iterations; ++i)
+				{
+					cv::Mat output;
+					reference_rgba_to_bgr(input, flipVertically, flipHorizontally, angles[a], output);
+				}
+				double reference = milliseconds(cv::getTickCount() - started) / iterations;
+
+				started = cv::getTickCount();
+				for (int i = 0; i < iterations; ++i)
+					utils_rgba_to_bgr(input, flipVertically, flipHorizontally, angles[a], actual);
+				double fused = milliseconds(cv::getTickCount() - started) / iterations;
+
+				printf("%4dx%-5d %6d %6d %6d %12.3f %12.3f %7.2fx\n", input.cols, input.rows, angles[a], flipVertically, flipHorizontally,
+					reference, fused, reference / std::max(fused, 1e-9));
+			}
+		}
+	}
+
+	if (failures)
+		printf("%d combination(s) differ from the reference\n", failures);
+	else
+		printf("all combinations are bit-exact\n");
+	return failures ? 1 : 0;
+}
@@ -1 +1,4 @@
-#include "aruco.h"
\ No newline at end of file
+#include "aruco.h"
+#include "aruco_MarkerTracker.h"
+#include "aruco_MarkerPoseTracker.h"
+#include "aruco_DictionaryIndex.h"
\ No newline at end of file
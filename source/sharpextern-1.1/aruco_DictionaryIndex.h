@@ -0,0 +1,322 @@
+#ifndef _CPP_ARUCO_DICTIONARYINDEX_H_
+#define _CPP_ARUCO_DICTIONARYINDEX_H_
+
+#include "include_opencv.h"
+
+#include <bitset>
+#include <unordered_map>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+// x86 popcount instruction is optional: the scan has a copy compiled for it and picks one at runtime
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define DICTIONARYINDEX_POPCNT_DISPATCH
+#define DICTIONARYINDEX_POPCNT_TARGET __attribute__((target("popcnt")))
+#define DICTIONARYINDEX_INLINE inline __attribute__((always_inline))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define DICTIONARYINDEX_POPCNT_DISPATCH
+#define DICTIONARYINDEX_POPCNT_TARGET
+#define DICTIONARYINDEX_INLINE __forceinline
+#else
+#define DICTIONARYINDEX_INLINE inline
+#endif
+
+//------------------------------------------------------------------------------------------------------
+// Dictionary index
+//
+// Bit-packed copy of cv::aruco::Dictionary codes: every marker in each of 4 rotations is a single uint64
+// (dictionaries are 7x7 bits at most), exact matches are resolved by a hash lookup and error-correcting
+// ones by a linear scan over the packed codes, one XOR and one popcount per code instead of per-byte
+// Hamming over bytesList. On x86 the scan uses the POPCNT instruction when the CPU has it (checked once,
+// at construction), elsewhere the compiler's popcount (NEON cnt on ARM64). Matching rules are the same
+// as cv::aruco::Dictionary::identify.
+//
+// decode() reads the bits of a marker candidate quad (perspective removal, Otsu, cell majority, border
+// check, all the way aruco does) and identifies them, it's what MarkerTracker ROI detection runs on
+//------------------------------------------------------------------------------------------------------
+
+#pragma region DictionaryIndex
+
+class DictionaryIndex
+{
+public:
+	DictionaryIndex(const cv::aruco::Dictionary &dictionary)
+		: markerSize(dictionary.markerSize), maxCorrectionBits(dictionary.maxCorrectionBits)
+	{
+#ifdef DICTIONARYINDEX_POPCNT_DISPATCH
+		nearest = cv::checkHardwareSupport(CV_CPU_POPCNT) ? &nearestPopcnt : &scan<PortablePopcount>;
+#else
+		nearest = &scan<PortablePopcount>;
+#endif
+
+		CV_Assert(markerSize * markerSize <= 64);
+
+		const cv::Mat &bytesList = dictionary.bytesList;
+		const int nbytes = bytesList.cols;
+		codes.resize(bytesList.rows * 4);
+		exact.reserve(codes.size());
+
+		cv::Mat rotationBytes(1, nbytes, CV_8UC4, cv::Scalar::all(0));
+		for (int m = 0; m < bytesList.rows; ++m)
+		{
+			for (int r = 0; r < 4; ++r)
+			{
+				// rotation r bytes are stored at r * nbytes, put them in place of rotation 0 and let aruco unpack them
+				memcpy(rotationBytes.ptr(), bytesList.ptr(m) + r * nbytes, nbytes);
+				uint64 code = pack(cv::aruco::Dictionary::getBitsFromByteList(rotationBytes, markerSize));
+
+				codes[m * 4 + r] = code;
+				exact.insert(std::make_pair(code, m * 4 + r));
+			}
+		}
+	}
+
+	/// <summary>
+	/// Packs markerSize x markerSize 0/1 bits matrix, row by row
+	/// </summary>
+	uint64 pack(const cv::Mat &bits) const
+	{
+		uint64 code = 0;
+		int k = 0;
+		for (int y = 0; y < markerSize; ++y)
+		{
+			const uchar *row = bits.ptr<uchar>(y);
+			for (int x = 0; x < markerSize; ++x, ++k)
+			{
+				if (row[x])
+					code |= (uint64)1 << k;
+			}
+		}
+		return code;
+	}
+
+	/// <summary>
+	/// Identifies packed marker code, see cv::aruco::Dictionary::identify
+	/// </summary>
+	/// <returns>True if code matches one of the markers within the allowed number of erroneous bits</returns>
+	bool identify(uint64 code, double maxCorrectionRate, int &idx, int &rotation) const
+	{
+		auto found = exact.find(code);
+		if (exact.end() != found)
+		{
+			idx = found->second / 4;
+			rotation = found->second % 4;
+			return true;
+		}
+
+		const int maxCorrection = int(double(maxCorrectionBits) * maxCorrectionRate);
+		if (maxCorrection <= 0)
+			return false;
+
+		return nearest(codes.data(), (int)codes.size() / 4, code, maxCorrection, idx, rotation);
+	}
+
+	bool identify(const cv::Mat &bits, double maxCorrectionRate, int &idx, int &rotation) const
+	{
+		CV_Assert(bits.rows == markerSize && bits.cols == markerSize && bits.type() == CV_8UC1);
+		return identify(pack(bits), maxCorrectionRate, idx, rotation);
+	}
+
+	/// <summary>
+	/// Reads candidate quad bits and identifies them, same as aruco does for every detectMarkers candidate
+	/// </summary>
+	/// <param name="grey">8-bit grayscale image the candidate has been found on</param>
+	/// <param name="corners">[in/out] Candidate corners, rotated to the marker orientation once identified</param>
+	/// <param name="params">Bits extraction (perspectiveRemove*, minOtsuStdDev, markerBorderBits) and correction rates</param>
+	/// <returns>True if the border is within maxErroneousBitsInBorderRate and the bits match one of the markers</returns>
+	bool decode(const cv::Mat &grey, std::vector<cv::Point2f> &corners, const cv::aruco::DetectorParameters &params, int &idx)
+	{
+		CV_Assert(corners.size() == 4 && grey.type() == CV_8UC1);
+
+		const int borderBits = params.markerBorderBits;
+		const int cells = markerSize + 2 * borderBits;
+		const int cellSize = params.perspectiveRemovePixelPerCell;
+		const int cellMargin = int(params.perspectiveRemoveIgnoredMarginPerCell * cellSize);
+		const int side = cells * cellSize;
+
+		// #0 perspective removal
+		const cv::Point2f square[] = { cv::Point2f(0, 0), cv::Point2f((float)side - 1, 0), cv::Point2f((float)side - 1, (float)side - 1), cv::Point2f(0, (float)side - 1) };
+		cv::warpPerspective(grey, warped, cv::getPerspectiveTransform(corners.data(), square), cv::Size(side, side), cv::INTER_NEAREST);
+
+		// #1 cells, Otsu unless the inner region is flat (then all cells are alike)
+		bits.create(cells, cells, CV_8UC1);
+		cv::Scalar mean, stddev;
+		const int half = cellSize / 2;
+		cv::meanStdDev(warped(cv::Rect(half, half, side - 2 * half, side - 2 * half)), mean, stddev);
+		if (stddev[0] < params.minOtsuStdDev)
+		{
+			bits.setTo(cv::Scalar::all(mean[0] > 127 ? 1 : 0));
+		}
+		else
+		{
+			cv::threshold(warped, warped, 125, 255, cv::THRESH_BINARY | cv::THRESH_OTSU);
+			const cv::Size inner(cellSize - 2 * cellMargin, cellSize - 2 * cellMargin);
+			for (int y = 0; y < cells; ++y)
+			{
+				uchar *row = bits.ptr<uchar>(y);
+				for (int x = 0; x < cells; ++x)
+				{
+					cv::Mat cell = warped(cv::Rect(cv::Point(x * cellSize + cellMargin, y * cellSize + cellMargin), inner));
+					row[x] = (cv::countNonZero(cell) > (int)cell.total() / 2) ? 1 : 0;
+				}
+			}
+		}
+
+		// #2 border must be black, then the code
+		cv::Mat onlyBits = bits(cv::Rect(borderBits, borderBits, markerSize, markerSize));
+		int borderErrors = cv::countNonZero(bits) - cv::countNonZero(onlyBits);
+		if (borderErrors > int(markerSize * markerSize * params.maxErroneousBitsInBorderRate))
+			return false;
+
+		int rotation;
+		if (!identify(pack(onlyBits), params.errorCorrectionRate, idx, rotation))
+			return false;
+
+		if (0 != rotation)
+			std::rotate(corners.begin(), corners.begin() + 4 - rotation, corners.end());
+		return true;
+	}
+
+	int size() const
+	{
+		return (int)codes.size() / 4;
+	}
+
+private:
+	typedef bool (*NearestFunction)(const uint64 *codes, int count, uint64 code, int maxCorrection, int &idx, int &rotation);
+
+	/// <summary>
+	/// The first marker within maxCorrection bits from the code wins, as aruco does; codes are 4 rotations per marker
+	/// </summary>
+	template <typename Popcount>
+	static DICTIONARYINDEX_INLINE bool scan(const uint64 *codes, int count, uint64 code, int maxCorrection, int &idx, int &rotation)
+	{
+		for (int m = 0; m < count; ++m, codes += 4)
+		{
+			int d0 = Popcount::count(codes[0] ^ code), d1 = Popcount::count(codes[1] ^ code);
+			int d2 = Popcount::count(codes[2] ^ code), d3 = Popcount::count(codes[3] ^ code);
+			int best = std::min(std::min(d0, d1), std::min(d2, d3));
+			if (best <= maxCorrection)
+			{
+				idx = m;
+				rotation = (best == d0) ? 0 : (best == d1) ? 1 : (best == d2) ? 2 : 3;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	struct PortablePopcount
+	{
+		static DICTIONARYINDEX_INLINE int count(uint64 v)
+		{
+#if defined(__GNUC__) || defined(__clang__)
+			return __builtin_popcountll(v);
+#else
+			return (int)std::bitset<64>(v).count();
+#endif
+		}
+	};
+
+#ifdef DICTIONARYINDEX_POPCNT_DISPATCH
+	struct HardwarePopcount
+	{
+		static DICTIONARYINDEX_INLINE int count(uint64 v)
+		{
+#if defined(_MSC_VER) && defined(_M_X64)
+			return (int)__popcnt64(v);
+#elif defined(_MSC_VER)
+			return (int)(__popcnt((unsigned)v) + __popcnt((unsigned)(v >> 32)));
+#else
+			return __builtin_popcountll(v);
+#endif
+		}
+	};
+
+	/// <summary>
+	/// The scan compiled for the POPCNT instruction, called only if the CPU has it
+	/// </summary>
+	static DICTIONARYINDEX_POPCNT_TARGET bool nearestPopcnt(const uint64 *codes, int count, uint64 code, int maxCorrection, int &idx, int &rotation)
+	{
+		return scan<HardwarePopcount>(codes, count, code, maxCorrection, idx, rotation);
+	}
+#endif
+
+public:
+	const int markerSize;
+	const int maxCorrectionBits;
+
+private:
+	std::vector<uint64> codes;						// marker m rotation r at m * 4 + r
+	std::unordered_map<uint64, int> exact;			// code -> m * 4 + r
+	NearestFunction nearest;						// error-correcting scan for this CPU
+
+	// decode() buffers
+	cv::Mat warped;
+	cv::Mat bits;
+};
+
+//------------------------------------------------------------------------------------------------------
+// C-wrapper
+//------------------------------------------------------------------------------------------------------
+
+/// <summary>
+/// Builds index over the dictionary codes, dictionary is not referenced afterwards
+/// </summary>
+CVAPI(DictionaryIndex*) aruco_DictionaryIndex_new(cv::Ptr<cv::aruco::Dictionary> *dictionary)
+{
+	return new DictionaryIndex(**dictionary);
+}
+
+CVAPI(void) aruco_DictionaryIndex_delete(DictionaryIndex *obj)
+{
+	delete obj;
+}
+
+CVAPI(int) aruco_DictionaryIndex_size(DictionaryIndex *obj)
+{
+	return obj->size();
+}
+
+/// <summary>
+/// Identifies marker bits, same as cv::aruco::Dictionary::identify
+/// </summary>
+/// <param name="onlyBits">[in] markerSize x markerSize CV_8UC1 matrix of 0/1 bits, without the border</param>
+/// <param name="idx">[out] Marker id</param>
+/// <param name="rotation">[out] Marker rotation</param>
+/// <returns>1 if identified, 0 otherwise</returns>
+CVAPI(int) aruco_DictionaryIndex_identify(DictionaryIndex *obj, cv::Mat *onlyBits, double maxCorrectionRate, int *idx, int *rotation)
+{
+	return obj->identify(*onlyBits, maxCorrectionRate, *idx, *rotation) ? 1 : 0;
+}
+
+/// <summary>
+/// Identifies a batch of packed codes (bits row by row, bit k of the code is bit (k / markerSize, k % markerSize))
+/// </summary>
+/// <param name="ids">[out] Marker ids, -1 for not identified codes</param>
+/// <param name="rotations">[out] Markers rotations, might be null</param>
+/// <returns>Number of identified codes</returns>
+CVAPI(int) aruco_DictionaryIndex_identifyBatch(DictionaryIndex *obj, const uint64 *codes, int count, double maxCorrectionRate, int *ids, int *rotations)
+{
+	int identified = 0;
+	for (int i = 0; i < count; ++i)
+	{
+		int idx = -1, rotation = -1;
+		if (obj->identify(codes[i], maxCorrectionRate, idx, rotation))
+			++identified;
+		else
+			idx = rotation = -1;
+
+		ids[i] = idx;
+		if (nullptr != rotations)
+			rotations[i] = rotation;
+	}
+
+	return identified;
+}
+
+#pragma endregion
+
+#endif
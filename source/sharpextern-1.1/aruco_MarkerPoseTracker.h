@@ -0,0 +1,272 @@
+#ifndef _CPP_ARUCO_MARKERPOSETRACKER_H_
+#define _CPP_ARUCO_MARKERPOSETRACKER_H_
+
+#include "include_opencv.h"
+#include "aruco_MarkerTracker.h"
+
+#include <map>
+
+//------------------------------------------------------------------------------------------------------
+// Marker pose tracker
+//
+// Detection, per marker pose estimation and temporal smoothing within a single call. Markers are found
+// by MarkerTracker, solvePnP is warm-started from the marker previous raw pose and the result is blended
+// with the previous smoothed one (quaternion nlerp for rotation, lerp for translation). Per-id state is
+// dropped once the marker is missing for more than maxMissedFrames frames
+//------------------------------------------------------------------------------------------------------
+
+#pragma region MarkerPoseTracker
+
+class MarkerPoseTracker
+{
+public:
+	MarkerPoseTracker(const cv::Ptr<cv::aruco::Dictionary> &dictionary, const cv::Ptr<cv::aruco::DetectorParameters> &parameters,
+		float markerLength, const cv::Mat &cameraMatrix, const cv::Mat &distCoeffs)
+		: tracker(dictionary, parameters), smoothing(0.5), maxMissedFrames(5), cameraMatrix(cameraMatrix.clone()), distCoeffs(distCoeffs.clone())
+	{
+		// same layout as cv::aruco::estimatePoseSingleMarkers
+		objectPoints.push_back(cv::Point3f(-markerLength / 2.f, markerLength / 2.f, 0));
+		objectPoints.push_back(cv::Point3f(markerLength / 2.f, markerLength / 2.f, 0));
+		objectPoints.push_back(cv::Point3f(markerLength / 2.f, -markerLength / 2.f, 0));
+		objectPoints.push_back(cv::Point3f(-markerLength / 2.f, -markerLength / 2.f, 0));
+	}
+
+	/// <summary>
+	/// Detects markers and estimates their smoothed poses
+	/// </summary>
+	/// <param name="image">8-bit grayscale or BGR image</param>
+	const std::vector<aruco_MarkerPose>& process(const cv::Mat &image)
+	{
+		bool fullScan = false;
+		tracker.track(image, corners, ids, fullScan);
+
+		for (auto it = states.begin(); it != states.end(); ++it)
+			it->second.seen = false;
+
+		poses.resize(ids.size());
+		for (size_t i = 0; i < ids.size(); ++i)
+		{
+			aruco_MarkerPose &pose = poses[i];
+			pose.id = ids[i];
+
+			// the same id might show up twice, only the first one is tracked
+			auto found = states.find(ids[i]);
+			State *state = (states.end() != found && !found->second.seen) ? &found->second : nullptr;
+			bool duplicate = states.end() != found && found->second.seen;
+
+			cv::Vec3d rvec, tvec;
+			bool guess = nullptr != state;
+			if (guess)
+			{
+				rvec = state->rawR;
+				tvec = state->rawT;
+			}
+			cv::solvePnP(objectPoints, corners[i], cameraMatrix, distCoeffs, rvec, tvec, guess, cv::SOLVEPNP_ITERATIVE);
+			pose.reprojError = reprojectionError(corners[i], rvec, tvec);
+
+			cv::Vec4d q = rvecToQuat(rvec);
+			cv::Vec3d t = tvec;
+			if (nullptr != state)
+			{
+				q = nlerp(state->q, q, 1.0 - smoothing);
+				t = state->t * smoothing + tvec * (1.0 - smoothing);
+			}
+			if (!duplicate)
+			{
+				State &s = states[ids[i]];
+				s.rawR = rvec;
+				s.rawT = tvec;
+				s.q = q;
+				s.t = t;
+				s.missed = 0;
+				s.seen = true;
+			}
+
+			cv::Vec3d r = quatToRvec(q);
+			for (int k = 0; k < 3; ++k)
+			{
+				pose.rvec[k] = r[k];
+				pose.tvec[k] = t[k];
+			}
+		}
+
+		// forget markers missing for too long
+		for (auto it = states.begin(); it != states.end();)
+		{
+			if (!it->second.seen && ++it->second.missed > maxMissedFrames)
+				it = states.erase(it);
+			else
+				++it;
+		}
+
+		return poses;
+	}
+
+	/// <summary>
+	/// Forgets detected markers and their poses
+	/// </summary>
+	void reset()
+	{
+		tracker.reset();
+		states.clear();
+	}
+
+private:
+	struct State
+	{
+		cv::Vec3d rawR, rawT;				// solvePnP result, the next frame initial guess
+		cv::Vec4d q;						// smoothed rotation, (w, x, y, z)
+		cv::Vec3d t;						// smoothed translation
+		int missed;
+		bool seen;
+	};
+
+	double reprojectionError(const std::vector<cv::Point2f> &imagePoints, const cv::Vec3d &rvec, const cv::Vec3d &tvec)
+	{
+		cv::projectPoints(objectPoints, rvec, tvec, cameraMatrix, distCoeffs, projected);
+
+		double sum = 0;
+		for (size_t i = 0; i < projected.size(); ++i)
+		{
+			cv::Point2f d = projected[i] - imagePoints[i];
+			sum += d.dot(d);
+		}
+		return std::sqrt(sum / projected.size());
+	}
+
+	static cv::Vec4d rvecToQuat(const cv::Vec3d &rvec)
+	{
+		double theta = cv::norm(rvec);
+		if (theta < DBL_EPSILON)
+			return cv::Vec4d(1, 0, 0, 0);
+
+		double s = std::sin(theta * 0.5) / theta;
+		return cv::Vec4d(std::cos(theta * 0.5), rvec[0] * s, rvec[1] * s, rvec[2] * s);
+	}
+
+	static cv::Vec3d quatToRvec(cv::Vec4d q)
+	{
+		q *= 1.0 / cv::norm(q);
+		if (q[0] < 0)
+			q = -q;
+
+		double s = std::sqrt(std::max(0.0, 1.0 - q[0] * q[0]));
+		if (s < DBL_EPSILON)
+			return cv::Vec3d(0, 0, 0);
+
+		double theta = 2.0 * std::acos(std::min(1.0, q[0]));
+		return cv::Vec3d(q[1], q[2], q[3]) * (theta / s);
+	}
+
+	static cv::Vec4d nlerp(const cv::Vec4d &a, cv::Vec4d b, double alpha)
+	{
+		// shortest arc
+		if (a.dot(b) < 0)
+			b = -b;
+
+		cv::Vec4d q = a * (1.0 - alpha) + b * alpha;
+		return q * (1.0 / cv::norm(q));
+	}
+
+public:
+	MarkerTracker tracker;
+
+	// smoothing
+	double smoothing;						// 0 - raw poses, closer to 1 - smoother and laggier
+	int maxMissedFrames;
+
+private:
+	cv::Mat cameraMatrix;
+	cv::Mat distCoeffs;
+	std::vector<cv::Point3f> objectPoints;
+	std::map<int, State> states;
+
+	// per-frame buffers
+	std::vector<std::vector<cv::Point2f>> corners;
+	std::vector<int> ids;
+	std::vector<cv::Point2f> projected;
+	std::vector<aruco_MarkerPose> poses;
+};
+
+//------------------------------------------------------------------------------------------------------
+// C-wrapper
+//------------------------------------------------------------------------------------------------------
+
+/// <summary>
+/// Allocates new marker pose tracker
+/// </summary>
+/// <param name="dictionary">[in] Markers dictionary, shared with the caller</param>
+/// <param name="parameters">[in] Detector parameters, copied, might be null for defaults</param>
+/// <param name="markerLength">Marker side length, poses translation is in the same units</param>
+/// <param name="cameraMatrix">[in] 3x3 camera matrix, row by row</param>
+/// <param name="distCoeffs">[in] Distortion coefficients, might be null</param>
+CVAPI(MarkerPoseTracker*) aruco_MarkerPoseTracker_new(cv::Ptr<cv::aruco::Dictionary> *dictionary, cv::Ptr<cv::aruco::DetectorParameters> *parameters,
+	float markerLength, double *cameraMatrix, double *distCoeffs, int distCoeffsLength)
+{
+	cv::Mat cameraMatrixMat(3, 3, cv::DataType<double>::type, cameraMatrix);
+	cv::Mat distCoeffsMat;
+	if (distCoeffs != NULL)
+		distCoeffsMat = cv::Mat(distCoeffsLength, 1, cv::DataType<double>::type, distCoeffs);
+
+	return new MarkerPoseTracker(*dictionary, (nullptr != parameters) ? *parameters : cv::Ptr<cv::aruco::DetectorParameters>(),
+		markerLength, cameraMatrixMat, distCoeffsMat);
+}
+
+CVAPI(void) aruco_MarkerPoseTracker_delete(MarkerPoseTracker *obj)
+{
+	delete obj;
+}
+
+/// <summary>
+/// Replaces detector parameters with a copy of the given ones, null for defaults
+/// </summary>
+CVAPI(void) aruco_MarkerPoseTracker_setParameters(MarkerPoseTracker *obj, cv::Ptr<cv::aruco::DetectorParameters> *parameters)
+{
+	obj->tracker.setParameters((nullptr != parameters) ? *parameters : cv::Ptr<cv::aruco::DetectorParameters>());
+}
+
+/// <summary>
+/// Detection parameters, see aruco_MarkerTracker_setTrackingParams and aruco_MarkerTracker_setPyramidScale
+/// </summary>
+CVAPI(void) aruco_MarkerPoseTracker_setTrackingParams(MarkerPoseTracker *obj, int rescanInterval, double roiPadding, double pyramidScale)
+{
+	obj->tracker.rescanInterval = rescanInterval;
+	obj->tracker.roiPadding = std::max(0.0, roiPadding);
+	obj->tracker.pyramidScale = std::max(0.0, pyramidScale);
+}
+
+/// <summary>
+/// Temporal smoothing parameters
+/// </summary>
+/// <param name="smoothing">Weight of the previous pose, [0, 1), 0 to output raw poses</param>
+/// <param name="maxMissedFrames">Marker state (previous pose) is kept for that many frames it's missing</param>
+CVAPI(void) aruco_MarkerPoseTracker_setSmoothing(MarkerPoseTracker *obj, double smoothing, int maxMissedFrames)
+{
+	obj->smoothing = std::min(std::max(0.0, smoothing), 0.99);
+	obj->maxMissedFrames = std::max(0, maxMissedFrames);
+}
+
+/// <summary>
+/// Detects markers and writes their smoothed poses into the pre-allocated buffer
+/// </summary>
+/// <param name="image">[in] 8-bit grayscale or BGR image</param>
+/// <param name="output">[out] Poses buffer</param>
+/// <param name="outputLength">Buffer capacity in poses</param>
+/// <returns>Number of markers detected, only first outputLength of them are written</returns>
+CVAPI(int) aruco_MarkerPoseTracker_process(MarkerPoseTracker *obj, cv::Mat *image, aruco_MarkerPose *output, int outputLength)
+{
+	const std::vector<aruco_MarkerPose> &poses = obj->process(*image);
+	if (nullptr != output && outputLength > 0)
+		std::copy(poses.begin(), poses.begin() + std::min((int)poses.size(), outputLength), output);
+
+	return (int)poses.size();
+}
+
+CVAPI(void) aruco_MarkerPoseTracker_reset(MarkerPoseTracker *obj)
+{
+	obj->reset();
+}
+
+#pragma endregion
+
+#endif
@@ -0,0 +1,391 @@
+#ifndef _CPP_ARUCO_MARKERTRACKER_H_
+#define _CPP_ARUCO_MARKERTRACKER_H_
+
+#include "include_opencv.h"
+#include "aruco_DictionaryIndex.h"
+
+//------------------------------------------------------------------------------------------------------
+// Marker tracker
+//
+// Stateful cv::aruco::detectMarkers: remembers where markers have been seen on the previous frame and
+// searches only padded ROIs around them, so thresholding and contours search run over a fraction of the
+// frame. Full frame is re-scanned every rescanInterval frames (that's when new markers are picked up)
+// or right away once any of the tracked markers is lost. Inside ROIs aruco only searches candidate quads,
+// their bits are read and identified by DictionaryIndex (hash lookup or packed codes scan).
+//
+// Full scans of high resolution frames might run coarse-to-fine: candidates are searched on a downscaled
+// copy, then markers are detected (corners and bits) at full resolution inside ROIs around them only
+//------------------------------------------------------------------------------------------------------
+
+#pragma region MarkerTracker
+
+class MarkerTracker
+{
+public:
+	MarkerTracker(const cv::Ptr<cv::aruco::Dictionary> &dictionary, const cv::Ptr<cv::aruco::DetectorParameters> &parameters)
+		: rescanInterval(15), roiPadding(0.5), pyramidScale(1.0), dictionary(dictionary), index(*dictionary), framesSinceScan(0)
+	{
+		// no codes, nothing is ever identified, so detectMarkers reports all the candidates as rejected; a single bit
+		// marker keeps its own (discarded) bits reading down to a few pixels
+		candidateDictionary = cv::makePtr<cv::aruco::Dictionary>(cv::Mat(0, 1, CV_8UC4), 1, 0);
+
+		setParameters(parameters);
+	}
+
+	/// <summary>
+	/// Copies detector parameters, null resets them to defaults
+	/// </summary>
+	void setParameters(const cv::Ptr<cv::aruco::DetectorParameters> &value)
+	{
+		parameters = value.empty() ? cv::aruco::DetectorParameters::create() : cv::makePtr<cv::aruco::DetectorParameters>(*value);
+		roiParameters = cv::makePtr<cv::aruco::DetectorParameters>(*parameters);
+		coarseParameters = cv::makePtr<cv::aruco::DetectorParameters>(*parameters);
+	}
+
+	/// <summary>
+	/// Downscale factor of the coarse detection for the given frame size, 1 if coarse-to-fine is off
+	/// </summary>
+	double coarseScale(const cv::Size &size) const
+	{
+		if (pyramidScale > 0)
+			return std::max(1.0, pyramidScale);
+
+		// auto: the smallest allowed marker is still ~2 pixels per cell on the downscaled frame
+		double minPerimeter = parameters->minMarkerPerimeterRate * std::max(size.width, size.height);
+		double cells = dictionary->markerSize + 2 * parameters->markerBorderBits;
+		return std::max(1.0, minPerimeter / (4 * cells * 2));
+	}
+
+	/// <summary>
+	/// Detects markers using previous frame results
+	/// </summary>
+	/// <param name="image">8-bit grayscale or BGR image</param>
+	/// <param name="fullScan">[out] True if the whole frame has been scanned</param>
+	void track(const cv::Mat &image, std::vector<std::vector<cv::Point2f>> &outCorners, std::vector<int> &outIds, bool &fullScan)
+	{
+		fullScan = ids.empty() || rescanInterval <= 1 || framesSinceScan + 1 >= rescanInterval || !trackInRois(image);
+		if (fullScan)
+		{
+			double scale = coarseScale(image.size());
+			if (scale > 1.0)
+				detectCoarseToFine(image, scale);
+			else
+				cv::aruco::detectMarkers(image, dictionary, corners, ids, parameters);
+			framesSinceScan = 0;
+		}
+		else
+		{
+			corners.swap(tracked);
+			ids.swap(trackedIds);
+			++framesSinceScan;
+		}
+
+		outCorners = corners;
+		outIds = ids;
+	}
+
+	/// <summary>
+	/// Forgets tracked markers, the next track() scans the full frame
+	/// </summary>
+	void reset()
+	{
+		corners.clear();
+		ids.clear();
+		framesSinceScan = 0;
+	}
+
+protected:
+	/// <summary>
+	/// Searches markers inside padded ROIs around the tracked ones, overlapping ROIs are merged
+	/// </summary>
+	/// <returns>False if any marker has been lost</returns>
+	bool trackInRois(const cv::Mat &image)
+	{
+		cv::Rect frame(0, 0, image.cols, image.rows);
+
+		rois.clear();
+		for (size_t i = 0; i < corners.size(); ++i)
+		{
+			cv::Rect box = cv::boundingRect(corners[i]);
+			int pad = cvRound(std::max(box.width, box.height) * roiPadding);
+			cv::Rect roi = cv::Rect(box.x - pad, box.y - pad, box.width + 2 * pad, box.height + 2 * pad) & frame;
+			if (roi.area() > 0)
+				rois.push_back(roi);
+		}
+		mergeRois();
+		detectInRois(image, tracked, trackedIds);
+
+		// every previous id must be there again, new ones might show up as well
+		std::vector<int> previous(ids), found(trackedIds);
+		std::sort(previous.begin(), previous.end());
+		std::sort(found.begin(), found.end());
+		return std::includes(found.begin(), found.end(), previous.begin(), previous.end());
+	}
+
+	/// <summary>
+	/// Coarse-to-fine full frame detection: candidates (decoded or not, bits might be unreadable when downscaled)
+	/// on the downscaled frame, markers themselves in full resolution ROIs around the candidates
+	/// </summary>
+	void detectCoarseToFine(const cv::Mat &image, double scale)
+	{
+		cv::resize(image, coarse, cv::Size(), 1.0 / scale, 1.0 / scale, cv::INTER_AREA);
+
+		// perimeter rates are relative and hold as is, window sizes and distances are in pixels
+		const cv::aruco::DetectorParameters &p = *parameters;
+		coarseParameters->adaptiveThreshWinSizeMin = std::max(3, cvRound(p.adaptiveThreshWinSizeMin / scale) | 1);
+		coarseParameters->adaptiveThreshWinSizeMax = std::max(coarseParameters->adaptiveThreshWinSizeMin, cvRound(p.adaptiveThreshWinSizeMax / scale) | 1);
+		coarseParameters->adaptiveThreshWinSizeStep = std::max(2, cvRound(p.adaptiveThreshWinSizeStep / scale / 2) * 2);	// keeps the windows odd
+		coarseParameters->minDistanceToBorder = cvRound(p.minDistanceToBorder / scale);
+		coarseParameters->doCornerRefinement = false;
+		cv::aruco::detectMarkers(coarse, dictionary, roiCorners, roiIds, coarseParameters, coarseRejected);
+
+		rois.clear();
+		cv::Rect frame(0, 0, image.cols, image.rows);
+		roiCorners.insert(roiCorners.end(), coarseRejected.begin(), coarseRejected.end());
+		for (size_t i = 0; i < roiCorners.size(); ++i)
+		{
+			cv::Rect box = cv::boundingRect(roiCorners[i]);
+			box = cv::Rect(cvFloor(box.x * scale), cvFloor(box.y * scale), cvCeil(box.width * scale), cvCeil(box.height * scale));
+
+			// at least a couple of coarse pixels around (the candidate outline is that precise) plus the border distance
+			int pad = std::max(cvRound(std::max(box.width, box.height) * roiPadding), cvCeil(2 * scale) + parameters->minDistanceToBorder);
+			cv::Rect roi = cv::Rect(box.x - pad, box.y - pad, box.width + 2 * pad, box.height + 2 * pad) & frame;
+			if (roi.area() > 0)
+				rois.push_back(roi);
+		}
+		mergeRois();
+		detectInRois(image, corners, ids);
+	}
+
+	/// <summary>
+	/// Detects markers inside every ROI at full resolution: aruco candidates search, DictionaryIndex decoding
+	/// </summary>
+	void detectInRois(const cv::Mat &image, std::vector<std::vector<cv::Point2f>> &outCorners, std::vector<int> &outIds)
+	{
+		outCorners.clear();
+		outIds.clear();
+		const int frameSize = std::max(image.cols, image.rows);
+		const cv::TermCriteria refinement(cv::TermCriteria::MAX_ITER | cv::TermCriteria::EPS, parameters->cornerRefinementMaxIterations, parameters->cornerRefinementMinAccuracy);
+		for (size_t i = 0; i < rois.size(); ++i)
+		{
+			const cv::Rect &roi = rois[i];
+
+			// perimeter rates are relative to the largest input dimension, scale them so the limits in pixels stay the same
+			double scale = (double)frameSize / std::max(roi.width, roi.height);
+			roiParameters->minMarkerPerimeterRate = parameters->minMarkerPerimeterRate * scale;
+			roiParameters->maxMarkerPerimeterRate = parameters->maxMarkerPerimeterRate * scale;
+
+			// gray ROI is shared by the candidates search, bits reading and corners refinement
+			cv::Mat grey = image(roi);
+			if (grey.channels() > 1)
+			{
+				cv::cvtColor(grey, roiGrey, (grey.channels() == 4) ? CV_BGRA2GRAY : CV_BGR2GRAY);
+				grey = roiGrey;
+			}
+
+			cv::aruco::detectMarkers(grey, candidateDictionary, roiCorners, roiIds, roiParameters, roiCandidates);
+			roiCorners.clear();
+			roiIds.clear();
+			for (size_t j = 0; j < roiCandidates.size(); ++j)
+			{
+				int id;
+				if (index.decode(grey, roiCandidates[j], *parameters, id))
+				{
+					roiCorners.push_back(roiCandidates[j]);
+					roiIds.push_back(id);
+				}
+			}
+			filterNested(roiCorners, roiIds);
+
+			for (size_t j = 0; j < roiIds.size(); ++j)
+			{
+				if (parameters->doCornerRefinement)
+					cv::cornerSubPix(grey, roiCorners[j], cv::Size(parameters->cornerRefinementWinSize, parameters->cornerRefinementWinSize), cv::Size(-1, -1), refinement);
+
+				for (size_t k = 0; k < roiCorners[j].size(); ++k)
+					roiCorners[j][k] += cv::Point2f((float)roi.x, (float)roi.y);
+
+				outCorners.push_back(roiCorners[j]);
+				outIds.push_back(roiIds[j]);
+			}
+		}
+	}
+
+	/// <summary>
+	/// Drops markers lying inside another one with the same id (inner and outer outlines of one border), as aruco does
+	/// </summary>
+	static void filterNested(std::vector<std::vector<cv::Point2f>> &markers, std::vector<int> &markerIds)
+	{
+		std::vector<bool> nested(markers.size(), false);
+		for (size_t i = 0; i < markers.size(); ++i)
+		{
+			for (size_t j = i + 1; j < markers.size(); ++j)
+			{
+				if (markerIds[i] != markerIds[j])
+					continue;
+				if (inside(markers[j], markers[i]))
+					nested[j] = true;
+				else if (inside(markers[i], markers[j]))
+					nested[i] = true;
+			}
+		}
+
+		size_t kept = 0;
+		for (size_t i = 0; i < markers.size(); ++i)
+		{
+			if (nested[i])
+				continue;
+			if (kept != i)
+			{
+				markers[kept].swap(markers[i]);
+				markerIds[kept] = markerIds[i];
+			}
+			++kept;
+		}
+		markers.resize(kept);
+		markerIds.resize(kept);
+	}
+
+	static bool inside(const std::vector<cv::Point2f> &quad, const std::vector<cv::Point2f> &outline)
+	{
+		for (size_t p = 0; p < quad.size(); ++p)
+		{
+			if (cv::pointPolygonTest(outline, quad[p], false) < 0)
+				return false;
+		}
+		return true;
+	}
+
+	/// <summary>
+	/// Replaces intersecting ROIs with their bounding rect until all of them are disjoint
+	/// </summary>
+	void mergeRois()
+	{
+		bool merged = true;
+		while (merged)
+		{
+			merged = false;
+			for (size_t i = 0; i < rois.size() && !merged; ++i)
+			{
+				for (size_t j = i + 1; j < rois.size(); ++j)
+				{
+					if ((rois[i] & rois[j]).area() > 0)
+					{
+						rois[i] |= rois[j];
+						rois.erase(rois.begin() + j);
+						merged = true;
+						break;
+					}
+				}
+			}
+		}
+	}
+
+public:
+	// tracking
+	int rescanInterval;
+	double roiPadding;
+
+	// coarse-to-fine full scans
+	double pyramidScale;
+
+private:
+	cv::Ptr<cv::aruco::Dictionary> dictionary;
+	cv::Ptr<cv::aruco::DetectorParameters> parameters;
+	cv::Ptr<cv::aruco::DetectorParameters> roiParameters;
+	cv::Ptr<cv::aruco::DetectorParameters> coarseParameters;
+	cv::Ptr<cv::aruco::Dictionary> candidateDictionary;
+	DictionaryIndex index;
+
+	// tracking state
+	std::vector<std::vector<cv::Point2f>> corners;
+	std::vector<int> ids;
+	int framesSinceScan;
+
+	// per-frame buffers
+	std::vector<cv::Rect> rois;
+	std::vector<std::vector<cv::Point2f>> tracked;
+	std::vector<int> trackedIds;
+	std::vector<std::vector<cv::Point2f>> roiCorners;
+	std::vector<int> roiIds;
+	std::vector<std::vector<cv::Point2f>> coarseRejected;
+	std::vector<std::vector<cv::Point2f>> roiCandidates;
+	cv::Mat roiGrey;
+	cv::Mat coarse;
+};
+
+//------------------------------------------------------------------------------------------------------
+// C-wrapper
+//------------------------------------------------------------------------------------------------------
+
+/// <summary>
+/// Allocates new marker tracker
+/// </summary>
+/// <param name="dictionary">[in] Markers dictionary, shared with the caller</param>
+/// <param name="parameters">[in] Detector parameters, copied, might be null for defaults</param>
+CVAPI(MarkerTracker*) aruco_MarkerTracker_new(cv::Ptr<cv::aruco::Dictionary> *dictionary, cv::Ptr<cv::aruco::DetectorParameters> *parameters)
+{
+	return new MarkerTracker(*dictionary, (nullptr != parameters) ? *parameters : cv::Ptr<cv::aruco::DetectorParameters>());
+}
+
+CVAPI(void) aruco_MarkerTracker_delete(MarkerTracker *obj)
+{
+	delete obj;
+}
+
+/// <summary>
+/// Replaces detector parameters with a copy of the given ones, null for defaults
+/// </summary>
+CVAPI(void) aruco_MarkerTracker_setParameters(MarkerTracker *obj, cv::Ptr<cv::aruco::DetectorParameters> *parameters)
+{
+	obj->setParameters((nullptr != parameters) ? *parameters : cv::Ptr<cv::aruco::DetectorParameters>());
+}
+
+/// <summary>
+/// Tracking parameters
+/// </summary>
+/// <param name="rescanInterval">Full frame is scanned every rescanInterval frames, 1 to scan every frame</param>
+/// <param name="roiPadding">Search ROI is the previous marker bounding rect padded by roiPadding of its size at every side</param>
+CVAPI(void) aruco_MarkerTracker_setTrackingParams(MarkerTracker *obj, int rescanInterval, double roiPadding)
+{
+	obj->rescanInterval = rescanInterval;
+	obj->roiPadding = std::max(0.0, roiPadding);
+}
+
+/// <summary>
+/// Coarse-to-fine mode of full frame scans, for high resolution frames
+/// </summary>
+/// <param name="pyramidScale">Coarse detection downscale factor: 1 to detect at full resolution only, 0 to pick it from
+/// minMarkerPerimeterRate (the smallest marker keeps ~2 pixels per cell)</param>
+CVAPI(void) aruco_MarkerTracker_setPyramidScale(MarkerTracker *obj, double pyramidScale)
+{
+	obj->pyramidScale = std::max(0.0, pyramidScale);
+}
+
+CVAPI(double) aruco_MarkerTracker_getPyramidScale(MarkerTracker *obj)
+{
+	return obj->pyramidScale;
+}
+
+/// <summary>
+/// Detects markers, same output as aruco_detectMarkers (without rejected candidates)
+/// </summary>
+/// <param name="image">[in] 8-bit grayscale or BGR image</param>
+/// <param name="corners">[out] Markers corners</param>
+/// <param name="ids">[out] Markers ids</param>
+/// <returns>1 if the whole frame has been scanned this time, 0 if only tracked ROIs</returns>
+CVAPI(int) aruco_MarkerTracker_track(MarkerTracker *obj, cv::Mat *image, std::vector<std::vector<cv::Point2f>> *corners, std::vector<int> *ids)
+{
+	bool scanned = false;
+	obj->track(*image, *corners, *ids, scanned);
+	return scanned ? 1 : 0;
+}
+
+CVAPI(void) aruco_MarkerTracker_reset(MarkerTracker *obj)
+{
+	obj->reset();
+}
+
+#pragma endregion
+
+#endif
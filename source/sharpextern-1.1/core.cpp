@@ -7,6 +7,7 @@
 #include "core_MatExpr.h"
 #include "core_OutputArray.h"
 #include "core_PCA.h"
+#include "core_Release.h"
 #include "core_RNG.h"
 #include "core_SparseMat.h"
 #include "core_SVD.h"
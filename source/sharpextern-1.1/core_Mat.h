@@ -2,6 +2,7 @@
 #define _CPP_CORE_MAT_H_
 
 #include "include_opencv.h"
+#include "core_MatPool.h"
 
 
 #pragma region Init & Release
@@ -16,11 +17,13 @@ CVAPI(cv::Mat*) core_Mat_new1()
 }
 CVAPI(cv::Mat*) core_Mat_new2(int rows, int cols, int type)
 {
-	return new cv::Mat(rows, cols, type); 
+	return core_MatPool_new(rows, cols, type);
 }
 CVAPI(cv::Mat*) core_Mat_new3(int rows, int cols, int type, MyCvScalar scalar)
 {
-	return new cv::Mat(rows, cols, type, cpp(scalar));
+	cv::Mat *ret = core_MatPool_new(rows, cols, type);
+	ret->setTo(cpp(scalar));
+	return ret;
 }
 CVAPI(cv::Mat*) core_Mat_new4(cv::Mat *mat, cv::Range rowRange, cv::Range colRange)
 {
@@ -83,6 +86,8 @@ CVAPI(void) core_Mat_release(cv::Mat *self)
 }
 CVAPI(void) core_Mat_delete(cv::Mat *self)
 {
+	if (MatPool::instance().enabled)
+		MatPool::instance().release(*self);
 	delete self;
 }
 
@@ -124,6 +129,13 @@ CVAPI(int) core_Mat_checkVector3(cv::Mat *self, int elemChannels, int depth, int
 
 CVAPI(cv::Mat*) core_Mat_clone(cv::Mat *self)
 {
+	if (2 == self->dims)
+	{
+		cv::Mat *ret = core_MatPool_new(self->rows, self->cols, self->type());
+		self->copyTo(*ret);
+		return ret;
+	}
+
 	cv::Mat ret = self->clone();
 	return new cv::Mat(ret);
 }
@@ -405,6 +417,13 @@ CVAPI(cv::Mat*) core_Mat_subMat2(cv::Mat *self, int nRanges, MyCvSlice *ranges)
 
 CVAPI(cv::Mat*) core_Mat_t(cv::Mat *self)
 {
+	if (MatPool::instance().enabled)
+	{
+		cv::Mat *ret = core_MatPool_new(self->cols, self->rows, self->type());
+		cv::transpose(*self, *ret);
+		return ret;
+	}
+
 	cv::Mat expr = self->t();
 	return new cv::Mat(expr);
 }
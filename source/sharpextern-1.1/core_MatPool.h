@@ -0,0 +1,235 @@
+#ifndef _CPP_CORE_MATPOOL_H_
+#define _CPP_CORE_MATPOOL_H_
+
+#include "include_opencv.h"
+
+#include <atomic>
+#include <map>
+#include <mutex>
+
+//------------------------------------------------------------------------------------------------------
+// Mat pool
+//
+// Process-wide pool of cv::Mat buffers keyed by (rows, cols, type). Buffers are recycled when the last
+// Mat referencing them is deleted through the pool, so per-frame Mats of the same geometry stop hitting
+// the heap. Finalizers run on their own thread, hence the lock
+//------------------------------------------------------------------------------------------------------
+
+#pragma region MatPool
+
+class MatPool
+{
+public:
+	/// <summary>
+	/// The single pool instance
+	/// </summary>
+	static MatPool& instance()
+	{
+		static MatPool pool;
+		return pool;
+	}
+
+	/// <summary>
+	/// Pooled Mat of the given geometry, newly allocated if the pool has none
+	/// </summary>
+	cv::Mat acquire(int rows, int cols, int type)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			std::vector<cv::Mat> &list = buffers[key(rows, cols, type)];
+			if (!list.empty())
+			{
+				cv::Mat mat = list.back();
+				list.pop_back();
+
+				bytesHeld -= mat.total() * mat.elemSize();
+				++hits;
+				return mat;
+			}
+			++misses;
+		}
+
+		return cv::Mat(rows, cols, type);
+	}
+
+	/// <summary>
+	/// Takes Mat buffer back if it's poolable: owned by OpenCV, referenced by this Mat only, continuous, not a ROI
+	/// and fits into the capacity. Mat is released in any case
+	/// </summary>
+	/// <returns>True if buffer has been pooled</returns>
+	bool release(cv::Mat &mat)
+	{
+		bool pooled = false;
+		if (poolable(mat))
+		{
+			size_t bytes = mat.total() * mat.elemSize();
+
+			std::lock_guard<std::mutex> lock(mutex);
+			if (bytesHeld + bytes <= capacity)
+			{
+				buffers[key(mat.rows, mat.cols, mat.type())].push_back(mat);
+				bytesHeld += bytes;
+				pooled = true;
+			}
+		}
+
+		mat.release();
+		return pooled;
+	}
+
+	/// <summary>
+	/// Drops all pooled buffers
+	/// </summary>
+	void clear()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		buffers.clear();
+		bytesHeld = 0;
+	}
+
+	/// <summary>
+	/// Sets max bytes pool may hold, drops buffers exceeding it
+	/// </summary>
+	void setCapacity(size_t value)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		capacity = value;
+		for (auto it = buffers.begin(); it != buffers.end() && bytesHeld > capacity; ++it)
+		{
+			std::vector<cv::Mat> &list = it->second;
+			while (!list.empty() && bytesHeld > capacity)
+			{
+				bytesHeld -= list.back().total() * list.back().elemSize();
+				list.pop_back();
+			}
+		}
+	}
+
+	size_t getCapacity() const
+	{
+		return capacity;
+	}
+
+	void getStats(uint64 *outHits, uint64 *outMisses, uint64 *outBytesHeld, int *outBuffersHeld)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		*outHits = hits;
+		*outMisses = misses;
+		*outBytesHeld = bytesHeld;
+
+		size_t count = 0;
+		for (auto it = buffers.begin(); it != buffers.end(); ++it)
+			count += it->second.size();
+		*outBuffersHeld = (int)count;
+	}
+
+	void resetStats()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		hits = 0;
+		misses = 0;
+	}
+
+public:
+	/// <summary>
+	/// When set, Mat constructors/factories listed in core_Mat.h draw from the pool and core_Mat_delete recycles
+	/// </summary>
+	std::atomic<bool> enabled;
+
+private:
+	typedef std::pair<std::pair<int, int>, int> Key;
+
+	MatPool()
+		: enabled(false), capacity(64 * 1024 * 1024), bytesHeld(0), hits(0), misses(0)
+	{}
+
+	static Key key(int rows, int cols, int type)
+	{
+		return Key(std::make_pair(rows, cols), type);
+	}
+
+	static bool poolable(const cv::Mat &mat)
+	{
+		return nullptr != mat.u && nullptr == mat.u->userdata && 1 == mat.u->refcount && 2 == mat.dims &&
+			mat.isContinuous() && !mat.isSubmatrix() && mat.data == mat.datastart;
+	}
+
+private:
+	std::mutex mutex;
+	std::map<Key, std::vector<cv::Mat>> buffers;
+	size_t capacity;
+	size_t bytesHeld;
+	uint64 hits;
+	uint64 misses;
+};
+
+/// <summary>
+/// New Mat header for the given geometry, drawn from the pool if it's enabled
+/// </summary>
+static cv::Mat* core_MatPool_new(int rows, int cols, int type)
+{
+	MatPool &pool = MatPool::instance();
+	if (pool.enabled && rows > 0 && cols > 0)
+		return new cv::Mat(pool.acquire(rows, cols, type));
+
+	return new cv::Mat(rows, cols, type);
+}
+
+//------------------------------------------------------------------------------------------------------
+// C-wrapper
+//------------------------------------------------------------------------------------------------------
+
+/// <summary>
+/// Takes Mat from the pool (regardless of the enabled flag), contents are undefined
+/// </summary>
+CVAPI(cv::Mat*) core_MatPool_acquire(int rows, int cols, int type)
+{
+	return new cv::Mat(MatPool::instance().acquire(rows, cols, type));
+}
+
+/// <summary>
+/// Deletes Mat returning its buffer into the pool when possible (regardless of the enabled flag)
+/// </summary>
+/// <returns>1 if buffer has been pooled, 0 if it's been released</returns>
+CVAPI(int) core_MatPool_release(cv::Mat *mat)
+{
+	int pooled = MatPool::instance().release(*mat) ? 1 : 0;
+	delete mat;
+	return pooled;
+}
+
+CVAPI(void) core_MatPool_setEnabled(int value)
+{
+	MatPool::instance().enabled = value != 0;
+}
+CVAPI(int) core_MatPool_getEnabled()
+{
+	return MatPool::instance().enabled ? 1 : 0;
+}
+
+CVAPI(void) core_MatPool_setCapacity(uint64 bytes)
+{
+	MatPool::instance().setCapacity((size_t)bytes);
+}
+CVAPI(uint64) core_MatPool_getCapacity()
+{
+	return MatPool::instance().getCapacity();
+}
+
+CVAPI(void) core_MatPool_clear()
+{
+	MatPool::instance().clear();
+}
+
+CVAPI(void) core_MatPool_getStats(uint64 *hits, uint64 *misses, uint64 *bytesHeld, int *buffersHeld)
+{
+	MatPool::instance().getStats(hits, misses, bytesHeld, buffersHeld);
+}
+CVAPI(void) core_MatPool_resetStats()
+{
+	MatPool::instance().resetStats();
+}
+
+#pragma endregion
+
+#endif
@@ -0,0 +1,134 @@
+#ifndef _CPP_CORE_RELEASE_H_
+#define _CPP_CORE_RELEASE_H_
+
+#include "include_opencv.h"
+#include "core_MatPool.h"
+
+//------------------------------------------------------------------------------------------------------
+// Batched release
+//
+// Releases a whole set of wrapped objects within a single call instead of one P/Invoke transition per
+// object. Each object comes with a type tag, the values must match OpenCvSharp.NativeHandleType
+//------------------------------------------------------------------------------------------------------
+
+#pragma region Release
+
+enum NativeHandleType
+{
+	NativeHandle_Mat = 0,
+	NativeHandle_Ptr = 1,					// any cv::Ptr<T>*, released as cv::Ptr<void>*, see core_releaseHandle
+
+	NativeHandle_VectorUChar = 10,
+	NativeHandle_VectorInt32,
+	NativeHandle_VectorFloat,
+	NativeHandle_VectorDouble,
+	NativeHandle_VectorVec2f,
+	NativeHandle_VectorVec3f,
+	NativeHandle_VectorVec4f,
+	NativeHandle_VectorVec4i,
+	NativeHandle_VectorVec6f,
+	NativeHandle_VectorVec6d,
+	NativeHandle_VectorPoint,
+	NativeHandle_VectorPoint2f,
+	NativeHandle_VectorPoint3f,
+	NativeHandle_VectorRect,
+	NativeHandle_VectorKeyPoint,
+	NativeHandle_VectorDMatch,
+	NativeHandle_VectorString,
+	NativeHandle_VectorMat,
+
+	NativeHandle_VectorVectorInt = 40,
+	NativeHandle_VectorVectorFloat,
+	NativeHandle_VectorVectorDouble,
+	NativeHandle_VectorVectorKeyPoint,
+	NativeHandle_VectorVectorDMatch,
+	NativeHandle_VectorVectorPoint,
+	NativeHandle_VectorVectorPoint2f,
+	NativeHandle_VectorVectorVec2i
+};
+
+/// <summary>
+/// Deletes object of the given type
+/// </summary>
+/// <returns>False if type is unknown, object is left untouched then</returns>
+static bool core_releaseHandle(int type, void *obj)
+{
+	switch (type)
+	{
+	case NativeHandle_Mat:
+		{
+			// same as core_Mat_delete
+			cv::Mat *mat = static_cast<cv::Mat*>(obj);
+			if (MatPool::instance().enabled)
+				MatPool::instance().release(*mat);
+			delete mat;
+		}
+		break;
+	case NativeHandle_Ptr:
+		// NOTE: strictly speaking this deletes cv::Ptr<T> through the wrong type, which is undefined behaviour. It relies on
+		// OpenCV 3.x cv::Ptr<T> being layout-identical for every T (stored pointer + type-erased PtrOwner that knows how to
+		// delete the real object), so ~Ptr<void> drops the reference exactly as ~Ptr<T> would. Revisit on cv::Ptr changes
+		static_assert(sizeof(cv::Ptr<void>) == sizeof(cv::Ptr<cv::Algorithm>), "cv::Ptr<T> layout must not depend on T");
+		delete static_cast<cv::Ptr<void>*>(obj);
+		break;
+
+	case NativeHandle_VectorUChar:				delete static_cast<std::vector<uchar>*>(obj); break;
+	case NativeHandle_VectorInt32:				delete static_cast<std::vector<int>*>(obj); break;
+	case NativeHandle_VectorFloat:				delete static_cast<std::vector<float>*>(obj); break;
+	case NativeHandle_VectorDouble:				delete static_cast<std::vector<double>*>(obj); break;
+	case NativeHandle_VectorVec2f:				delete static_cast<std::vector<cv::Vec2f>*>(obj); break;
+	case NativeHandle_VectorVec3f:				delete static_cast<std::vector<cv::Vec3f>*>(obj); break;
+	case NativeHandle_VectorVec4f:				delete static_cast<std::vector<cv::Vec4f>*>(obj); break;
+	case NativeHandle_VectorVec4i:				delete static_cast<std::vector<cv::Vec4i>*>(obj); break;
+	case NativeHandle_VectorVec6f:				delete static_cast<std::vector<cv::Vec6f>*>(obj); break;
+	case NativeHandle_VectorVec6d:				delete static_cast<std::vector<cv::Vec6d>*>(obj); break;
+	case NativeHandle_VectorPoint:				delete static_cast<std::vector<cv::Point>*>(obj); break;
+	case NativeHandle_VectorPoint2f:			delete static_cast<std::vector<cv::Point2f>*>(obj); break;
+	case NativeHandle_VectorPoint3f:			delete static_cast<std::vector<cv::Point3f>*>(obj); break;
+	case NativeHandle_VectorRect:				delete static_cast<std::vector<cv::Rect>*>(obj); break;
+	case NativeHandle_VectorKeyPoint:			delete static_cast<std::vector<cv::KeyPoint>*>(obj); break;
+	case NativeHandle_VectorDMatch:				delete static_cast<std::vector<cv::DMatch>*>(obj); break;
+	case NativeHandle_VectorString:				delete static_cast<std::vector<std::string>*>(obj); break;
+	case NativeHandle_VectorMat:				delete static_cast<std::vector<cv::Mat>*>(obj); break;
+
+	case NativeHandle_VectorVectorInt:			delete static_cast<std::vector<std::vector<int> >*>(obj); break;
+	case NativeHandle_VectorVectorFloat:		delete static_cast<std::vector<std::vector<float> >*>(obj); break;
+	case NativeHandle_VectorVectorDouble:		delete static_cast<std::vector<std::vector<double> >*>(obj); break;
+	case NativeHandle_VectorVectorKeyPoint:		delete static_cast<std::vector<std::vector<cv::KeyPoint> >*>(obj); break;
+	case NativeHandle_VectorVectorDMatch:		delete static_cast<std::vector<std::vector<cv::DMatch> >*>(obj); break;
+	case NativeHandle_VectorVectorPoint:		delete static_cast<std::vector<std::vector<cv::Point> >*>(obj); break;
+	case NativeHandle_VectorVectorPoint2f:		delete static_cast<std::vector<std::vector<cv::Point2f> >*>(obj); break;
+	case NativeHandle_VectorVectorVec2i:		delete static_cast<std::vector<std::vector<cv::Vec2i> >*>(obj); break;
+
+	default:
+		return false;
+	}
+
+	return true;
+}
+
+/// <summary>
+/// Releases a batch of objects
+/// </summary>
+/// <param name="types">[in] Type tags, see NativeHandleType</param>
+/// <param name="objects">[in] Object pointers, null entries are skipped</param>
+/// <param name="count">Number of objects</param>
+/// <returns>Number of objects released, unknown type tags are skipped</returns>
+CVAPI(int) core_releaseBatch(const int *types, void **objects, int count)
+{
+	int released = 0;
+	for (int i = 0; i < count; ++i)
+	{
+		if (nullptr == objects[i])
+			continue;
+
+		if (core_releaseHandle(types[i], objects[i]))
+			++released;
+	}
+
+	return released;
+}
+
+#pragma endregion
+
+#endif
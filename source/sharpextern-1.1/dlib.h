@@ -13,6 +13,25 @@
 // dlib bridge with OpenCV
 #include <dlib/opencv/cv_image.h>
 
+#include <map>
+#include <mutex>
+
+// memory mapping
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#endif
+
 //------------------------------------------------------------------------------------------------------
 // Auxiliary
 //------------------------------------------------------------------------------------------------------
@@ -30,6 +49,483 @@ public:
 	}
 };
 
+/// <summary>
+/// Read-only memory mapped file
+/// </summary>
+class MappedFile
+{
+public:
+	MappedFile(const char *fileName)
+		: data(nullptr), size(0)
+	{
+#ifdef _WIN32
+		file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		mapping = NULL;
+		if (INVALID_HANDLE_VALUE == file)
+			return;
+
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(file, &fileSize) || 0 == fileSize.QuadPart)
+			return;
+
+		mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (NULL == mapping)
+			return;
+
+		data = static_cast<char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+		if (nullptr != data)
+			size = (size_t)fileSize.QuadPart;
+#else
+		fd = open(fileName, O_RDONLY);
+		if (fd < 0)
+			return;
+
+		struct stat st;
+		if (0 != fstat(fd, &st) || 0 == st.st_size)
+			return;
+
+		void *mapped = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (MAP_FAILED == mapped)
+			return;
+
+		data = static_cast<char*>(mapped);
+		size = (size_t)st.st_size;
+#endif
+	}
+
+	~MappedFile()
+	{
+#ifdef _WIN32
+		if (nullptr != data)
+			UnmapViewOfFile(data);
+		if (NULL != mapping)
+			CloseHandle(mapping);
+		if (INVALID_HANDLE_VALUE != file)
+			CloseHandle(file);
+#else
+		if (nullptr != data)
+			munmap(data, size);
+		if (fd >= 0)
+			close(fd);
+#endif
+	}
+
+	char *data;
+	size_t size;
+
+private:
+	MappedFile(const MappedFile&);
+	MappedFile& operator=(const MappedFile&);
+
+#ifdef _WIN32
+	HANDLE file;
+	HANDLE mapping;
+#else
+	int fd;
+#endif
+};
+
+/// <summary>
+/// Process-wide cache of deserialized shape predictors keyed by the model content hash and size. Cached predictors are
+/// immutable and shared between all handles, each handle holds a reference, dlib_shapePredictor_delete drops it.
+/// Models are deserialized in full on the first load, not lazily: dlib::shape_predictor has no partial state to load
+/// trees on demand, so sharing is what saves memory and load time. Resident size is reported as the serialized size,
+/// the forests are plain float arrays and take about as much in memory as on disk
+/// </summary>
+class ShapePredictorCache
+{
+public:
+	static ShapePredictorCache& instance()
+	{
+		static ShapePredictorCache cache;
+		return cache;
+	}
+
+	/// <summary>
+	/// Shared predictor for the serialized model, deserialized only if there is no model with the same content yet.
+	/// Deserialization runs without the lock, so other models and handles are not blocked by a load
+	/// </summary>
+	dlib::shape_predictor* acquire(const char *data, size_t size)
+	{
+		const Key key(fnv1a(data, size), (uint64)size);
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (dlib::shape_predictor *shared = addRef(key))
+				return shared;
+		}
+
+		int64 started = cv::getTickCount();
+
+		dlib::shape_predictor *predictor = new dlib::shape_predictor();
+		try
+		{
+			membuf buf(const_cast<char*>(data), size);
+			std::istream stream(&buf);
+			dlib::deserialize(*predictor, stream);
+		}
+		catch (...)
+		{
+			delete predictor;
+			return nullptr;
+		}
+
+		const double loadTime = (cv::getTickCount() - started) * 1000.0 / cv::getTickFrequency();
+
+		std::lock_guard<std::mutex> lock(mutex);
+
+		// the same model might have been loaded concurrently, the first one wins
+		if (dlib::shape_predictor *shared = addRef(key))
+		{
+			delete predictor;
+			return shared;
+		}
+
+		Entry entry;
+		entry.predictor = predictor;
+		entry.refs = 1;
+		entry.residentBytes = (uint64)size;
+		entry.loadTime = loadTime;
+
+		models[key] = entry;
+		owners[predictor] = key;
+		lastLoadTime = loadTime;
+		totalLoadTime += loadTime;
+		return predictor;
+	}
+
+	/// <summary>
+	/// Drops a reference to the cached predictor
+	/// </summary>
+	/// <returns>False if predictor is not cached (i.e. owned by the caller)</returns>
+	bool release(dlib::shape_predictor *predictor)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		auto owner = owners.find(predictor);
+		if (owner == owners.end())
+			return false;
+
+		auto it = models.find(owner->second);
+		if (0 == --it->second.refs)
+		{
+			delete it->second.predictor;
+			models.erase(it);
+			owners.erase(owner);
+		}
+		return true;
+	}
+
+	bool contains(const dlib::shape_predictor *predictor)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return owners.count(const_cast<dlib::shape_predictor*>(predictor)) > 0;
+	}
+
+	void getStats(int *modelsCount, int *handlesCount, uint64 *residentBytes, double *lastLoad, double *totalLoad)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		*modelsCount = (int)models.size();
+		*handlesCount = 0;
+		*residentBytes = 0;
+		for (auto it = models.begin(); it != models.end(); ++it)
+		{
+			*handlesCount += it->second.refs;
+			*residentBytes += it->second.residentBytes;
+		}
+		*lastLoad = lastLoadTime;
+		*totalLoad = totalLoadTime;
+	}
+
+private:
+	// content hash and size, the hash alone might collide
+	typedef std::pair<uint64, uint64> Key;
+
+	struct Entry
+	{
+		dlib::shape_predictor *predictor;
+		int refs;
+		uint64 residentBytes;
+		double loadTime;
+	};
+
+	ShapePredictorCache()
+		: lastLoadTime(0), totalLoadTime(0)
+	{}
+
+	/// <summary>
+	/// Adds a reference to the cached model, the lock must be held
+	/// </summary>
+	/// <returns>Cached predictor, null if there is no such model</returns>
+	dlib::shape_predictor* addRef(const Key &key)
+	{
+		auto it = models.find(key);
+		if (it == models.end())
+			return nullptr;
+
+		it->second.refs++;
+		return it->second.predictor;
+	}
+
+	/// <summary>
+	/// 64-bit FNV-1a
+	/// </summary>
+	static uint64 fnv1a(const char *data, size_t size)
+	{
+		uint64 hash = 14695981039346656037ULL;
+		const unsigned char *bytes = reinterpret_cast<const unsigned char*>(data);
+		for (size_t i = 0; i < size; ++i)
+		{
+			hash ^= bytes[i];
+			hash *= 1099511628211ULL;
+		}
+		return hash;
+	}
+
+private:
+	std::mutex mutex;
+	std::map<Key, Entry> models;
+	std::map<dlib::shape_predictor*, Key> owners;
+	double lastLoadTime;
+	double totalLoadTime;
+};
+
+/// <summary>
+/// Runs shape predictor over a range of face rects, shape_predictor::operator() is const and safe to share
+/// </summary>
+template<typename pixel_type>
+class LandmarksInvoker : public cv::ParallelLoopBody
+{
+public:
+	LandmarksInvoker(const dlib::shape_predictor &predictor, const dlib::cv_image<pixel_type> &image, const MyCvRect *rois, int *output)
+		: predictor(predictor), image(image), rois(rois), output(output)
+	{}
+
+	virtual void operator() (const cv::Range &range) const
+	{
+		const int parts = (int)predictor.num_parts();
+		for (int i = range.start; i < range.end; ++i)
+		{
+			const MyCvRect &roi = rois[i];
+			dlib::full_object_detection fod = predictor(image, dlib::rectangle(roi.x, roi.y, roi.x + roi.width, roi.y + roi.height));
+
+			int *data = output + i * parts * 2;
+			for (int p = 0; p < parts; ++p)
+			{
+				*data++ = fod.part(p).x();
+				*data++ = fod.part(p).y();
+			}
+		}
+	}
+
+private:
+	const dlib::shape_predictor &predictor;
+	const dlib::cv_image<pixel_type> &image;
+	const MyCvRect *rois;
+	int *output;
+};
+
+/// <summary>
+/// Runs landmarks batch over the image wrapped as dlib image of the given pixel type
+/// </summary>
+template<typename pixel_type>
+static void dlib_landmarks_batch(const dlib::shape_predictor &predictor, const cv::Mat &image, const MyCvRect *rois, int roisCount, int *output)
+{
+	dlib::cv_image<pixel_type> img(image);
+	cv::parallel_for_(cv::Range(0, roisCount), LandmarksInvoker<pixel_type>(predictor, img, rois, output), roisCount);
+}
+
+/// <summary>
+/// Landmarks for a single face, see dlib_landmarks
+/// </summary>
+template<typename pixel_type>
+static dlib::full_object_detection dlib_landmarks_typed(const dlib::shape_predictor &predictor, const cv::Mat &image, const dlib::rectangle &rect)
+{
+	dlib::cv_image<pixel_type> img(image);
+	return predictor(img, rect);
+}
+
+/// <summary>
+/// Landmarks for a single face on grayscale, BGR or BGRA image. Color images are wrapped as is: shape predictor
+/// samples only a few hundred pixels around the face, dlib converts each of them to intensity as the channels average
+/// (same conversion dlib applies when models are trained on color images), so there is no full frame cvtColor
+/// </summary>
+/// <returns>False if image type is not supported</returns>
+static bool dlib_landmarks(const dlib::shape_predictor &predictor, const cv::Mat &image, const dlib::rectangle &rect, dlib::full_object_detection &fod)
+{
+	switch (image.type())
+	{
+	case CV_8UC1:	fod = dlib_landmarks_typed<unsigned char>(predictor, image, rect); return true;
+	case CV_8UC3:	fod = dlib_landmarks_typed<dlib::bgr_pixel>(predictor, image, rect); return true;
+	case CV_8UC4:	fod = dlib_landmarks_typed<dlib::rgb_alpha_pixel>(predictor, image, rect); return true;	// channels order doesn't matter for the average
+	default:		return false;
+	}
+}
+
+/// <summary>
+/// HOG frontal face detector with explicit image pyramid: every level is resized with OpenCV and scanned by its own
+/// single-level detector copy, so levels are processed in parallel and the pyramid step is not fixed by the scanner type
+/// </summary>
+class FaceDetector
+{
+public:
+	typedef dlib::frontal_face_detector detector_type;
+
+	FaceDetector(int threads)
+		: upsample(0), minFaceSize(0), pyramidDownscale(5.0 / 6.0), adjustThreshold(0)
+	{
+		detector_type original = dlib::get_frontal_face_detector();
+		windowSize = cv::Size((int)original.get_scanner().get_detection_window_width(), (int)original.get_scanner().get_detection_window_height());
+
+		// same detector with the internal pyramid disabled
+		detector_type::image_scanner_type scanner = original.get_scanner();
+		scanner.set_max_pyramid_levels(1);
+
+		std::vector<detector_type> parts;
+		for (unsigned long i = 0; i < original.num_detectors(); ++i)
+			parts.push_back(detector_type(scanner, original.get_overlap_tester(), original.get_w(i)));
+		detector_type single(parts);
+
+		if (threads <= 0)
+			threads = std::max(1, cv::getNumThreads());
+		detectors.assign(threads, single);
+		for (int i = threads - 1; i >= 0; --i)
+			freeSlots.push_back(i);
+	}
+
+	/// <summary>
+	/// Detects faces, results are ordered by confidence
+	/// </summary>
+	/// <param name="image">8-bit grayscale or BGR image</param>
+	const std::vector<dlib_FaceDetection>& detect(const cv::Mat &image)
+	{
+		if (image.channels() == 1)
+			gray = image;
+		else
+			cv::cvtColor(image, gray, (image.channels() == 4) ? CV_BGRA2GRAY : CV_BGR2GRAY);
+
+		// level scales: level 0 is upsampled, each next one is downscaled, faces smaller than minFaceSize or
+		// levels smaller than the detection window are skipped; the smallest face found is windowSize / 2^upsample
+		// anyway, so 0 (default) leaves the limit to the window and upsample
+		scales.clear();
+		double d = std::min(std::max(pyramidDownscale, 0.1), 0.99);
+		for (double scale = std::pow(2.0, upsample); gray.cols * scale >= windowSize.width && gray.rows * scale >= windowSize.height; scale *= d)
+		{
+			if (windowSize.width / scale >= minFaceSize)
+				scales.push_back(scale);
+		}
+
+		levels.resize(scales.size());
+		cv::parallel_for_(cv::Range(0, (int)scales.size()), LevelsInvoker(*this), std::min((int)scales.size(), (int)detectors.size()));
+
+		// merge levels: non-maximum suppression across the whole pyramid
+		std::vector<dlib::rect_detection> all;
+		for (size_t i = 0; i < levels.size(); ++i)
+			all.insert(all.end(), levels[i].begin(), levels[i].end());
+		std::sort(all.begin(), all.end(), [](const dlib::rect_detection &a, const dlib::rect_detection &b) { return a.detection_confidence > b.detection_confidence; });
+
+		const dlib::test_box_overlap &overlaps = detectors[0].get_overlap_tester();
+		std::vector<dlib::rectangle> kept;
+		results.clear();
+		for (size_t i = 0; i < all.size(); ++i)
+		{
+			bool overlapped = false;
+			for (size_t j = 0; j < kept.size() && !overlapped; ++j)
+				overlapped = overlaps(all[i].rect, kept[j]);
+			if (overlapped)
+				continue;
+
+			kept.push_back(all[i].rect);
+
+			dlib_FaceDetection face;
+			face.rect.x = (int)all[i].rect.left();
+			face.rect.y = (int)all[i].rect.top();
+			face.rect.width = (int)all[i].rect.width();
+			face.rect.height = (int)all[i].rect.height();
+			face.confidence = all[i].detection_confidence;
+			face.weightIndex = (int)all[i].weight_index;
+			results.push_back(face);
+		}
+
+		return results;
+	}
+
+public:
+	int upsample;
+	int minFaceSize;
+	double pyramidDownscale;
+	double adjustThreshold;
+
+private:
+	class LevelsInvoker : public cv::ParallelLoopBody
+	{
+	public:
+		LevelsInvoker(FaceDetector &owner)
+			: owner(owner)
+		{}
+
+		virtual void operator() (const cv::Range &range) const
+		{
+			int slot = owner.acquireSlot();
+			for (int i = range.start; i < range.end; ++i)
+				owner.scanLevel(owner.detectors[slot], i);
+			owner.releaseSlot(slot);
+		}
+
+	private:
+		FaceDetector &owner;
+	};
+
+	/// <summary>
+	/// Scans single pyramid level, detections are mapped back to the source image
+	/// </summary>
+	void scanLevel(detector_type &detector, int index)
+	{
+		const double scale = scales[index];
+		cv::Mat level;
+		if (1.0 == scale)
+			level = gray;
+		else
+			cv::resize(gray, level, cv::Size(), scale, scale, scale < 1.0 ? cv::INTER_AREA : cv::INTER_LINEAR);
+
+		std::vector<dlib::rect_detection> &found = levels[index];
+		found.clear();
+		dlib::cv_image<unsigned char> img(level);
+		detector(img, found, adjustThreshold);
+
+		for (size_t i = 0; i < found.size(); ++i)
+		{
+			const dlib::rectangle &r = found[i].rect;
+			found[i].rect = dlib::rectangle((long)std::floor(r.left() / scale), (long)std::floor(r.top() / scale),
+				(long)std::ceil((r.right() + 1) / scale) - 1, (long)std::ceil((r.bottom() + 1) / scale) - 1);
+		}
+	}
+
+	int acquireSlot()
+	{
+		std::lock_guard<std::mutex> lock(slotsMutex);
+		int slot = freeSlots.back();
+		freeSlots.pop_back();
+		return slot;
+	}
+	void releaseSlot(int slot)
+	{
+		std::lock_guard<std::mutex> lock(slotsMutex);
+		freeSlots.push_back(slot);
+	}
+
+private:
+	cv::Size windowSize;
+	std::vector<detector_type> detectors;
+
+	// re-used between frames
+	cv::Mat gray;
+	std::vector<double> scales;
+	std::vector<std::vector<dlib::rect_detection>> levels;
+	std::vector<dlib_FaceDetection> results;
+
+	std::mutex slotsMutex;
+	std::vector<int> freeSlots;
+};
+
 //------------------------------------------------------------------------------------------------------
 // DLib minimal C-wrapper for face shape recognition
 //------------------------------------------------------------------------------------------------------
@@ -49,11 +545,12 @@ CVAPI(dlib::shape_predictor*) dlib_shapePredictor_new()
 /// <param name="predictor">[in] dlib::shape_predictor object to initialize with data. </param>
 /// <param name="dataArray">[in] buffer with predictor data. </param>
 /// <param name="dataSize">[in] buffer length. </param>
-CVAPI(void) dlib_shapePredictor_loadData(dlib::shape_predictor* predictor, char* dataArray, int dataSize)
+/// <returns>1 on success, -1 if arguments are invalid, the predictor is shared (those are immutable) or data is not a model</returns>
+CVAPI(int) dlib_shapePredictor_loadData(dlib::shape_predictor* predictor, char* dataArray, int dataSize)
 {
-	// quick check
-	if (nullptr == predictor || nullptr == dataArray)
-		return;
+	// quick check, shared predictors are immutable
+	if (nullptr == predictor || nullptr == dataArray || dataSize <= 0 || ShapePredictorCache::instance().contains(predictor))
+		return -1;
 
 	// get stream
 	membuf buf(dataArray, dataSize);
@@ -61,7 +558,56 @@ CVAPI(void) dlib_shapePredictor_loadData(dlib::shape_predictor* predictor, char*
 	stream.seekg(0);
 
 	// dlib de-serialization
-	dlib::deserialize(*predictor, stream);
+	try
+	{
+		dlib::deserialize(*predictor, stream);
+	}
+	catch (...)
+	{
+		return -1;
+	}
+	return 1;
+}
+
+/// <summary>
+/// Loads shared shape predictor from the model file, the file is memory mapped rather than read. Models with the same
+/// content are deserialized once per process and shared by all handles
+/// </summary>
+/// <param name="fileName">[in] Serialized dlib::shape_predictor file path</param>
+/// <returns>Shared dlib::shape_predictor handle, null if file can't be read or is not a model; release with dlib_shapePredictor_delete</returns>
+CVAPI(dlib::shape_predictor*) dlib_shapePredictor_loadShared(const char* fileName)
+{
+	MappedFile file(fileName);
+	if (nullptr == file.data)
+		return nullptr;
+
+	return ShapePredictorCache::instance().acquire(file.data, file.size);
+}
+
+/// <summary>
+/// Loads shared shape predictor from the in-memory model, see dlib_shapePredictor_loadShared
+/// </summary>
+/// <param name="dataArray">[in] buffer with predictor data</param>
+/// <param name="dataSize">[in] buffer length</param>
+CVAPI(dlib::shape_predictor*) dlib_shapePredictor_loadSharedData(char* dataArray, int dataSize)
+{
+	if (nullptr == dataArray || dataSize <= 0)
+		return nullptr;
+
+	return ShapePredictorCache::instance().acquire(dataArray, (size_t)dataSize);
+}
+
+/// <summary>
+/// Shared models statistics
+/// </summary>
+/// <param name="models">[out] Number of distinct models deserialized</param>
+/// <param name="handles">[out] Number of live handles to shared models</param>
+/// <param name="residentBytes">[out] Approximate memory held by shared models, the sum of their serialized sizes</param>
+/// <param name="lastLoadTime">[out] The latest model deserialization time, ms</param>
+/// <param name="totalLoadTime">[out] Total models deserialization time, ms</param>
+CVAPI(void) dlib_shapePredictor_getCacheStats(int* models, int* handles, uint64* residentBytes, double* lastLoadTime, double* totalLoadTime)
+{
+	ShapePredictorCache::instance().getStats(models, handles, residentBytes, lastLoadTime, totalLoadTime);
 }
 
 /// <summary>
@@ -69,7 +615,7 @@ CVAPI(void) dlib_shapePredictor_loadData(dlib::shape_predictor* predictor, char*
 /// </summary>
 ///
 /// <param name="predictor">[in] dlib::shape_predictor to use for landmark recognition</param>
-/// <param name="image">[in] Cv::Mat with image to detect fce shape on</param>
+/// <param name="image">[in] Cv::Mat with image to detect fce shape on: grayscale, BGR or BGRA, 8 bits per channel</param>
 /// <param name="roi">[in] Region of interest: the rect where the face is located (must be pre-detected with OpenCV or DLib)</param>
 /// <param name="landmarks">[in, out] If non-null, is filled with detected landmarks. </param>
 CVAPI(bool) dlib_shapePredictor_detectLandmarks(dlib::shape_predictor* predictor, cv::Mat* image, MyCvRect roi, std::vector<CvVec2i> **landmarks)
@@ -79,8 +625,9 @@ CVAPI(bool) dlib_shapePredictor_detectLandmarks(dlib::shape_predictor* predictor
 
 	// prepare
 	dlib::rectangle rect(roi.x, roi.y, roi.x + roi.width, roi.y + roi.height);
-	dlib::cv_image<unsigned char> img(*image);
-	dlib::full_object_detection fod = (*predictor)(img, rect);
+	dlib::full_object_detection fod;
+	if (!dlib_landmarks(*predictor, *image, rect, fod))
+		return false;
 
 	// parse to vector
 	*landmarks = new std::vector<CvVec2i>(fod.num_parts());
@@ -96,11 +643,114 @@ CVAPI(bool) dlib_shapePredictor_detectLandmarks(dlib::shape_predictor* predictor
 }
 
 /// <summary>
-/// Releases dlib::shape_detector
+/// Number of landmarks shape predictor detects per face
+/// </summary>
+CVAPI(int) dlib_shapePredictor_numParts(dlib::shape_predictor* predictor)
+{
+	return (int)predictor->num_parts();
+}
+
+/// <summary>
+/// Detects landmarks for a batch of faces in parallel, writes them into a single caller-owned buffer
+/// </summary>
+///
+/// <param name="predictor">[in] dlib::shape_predictor to use for landmark recognition</param>
+/// <param name="image">[in] Cv::Mat with image to detect face shapes on: grayscale, BGR or BGRA, 8 bits per channel</param>
+/// <param name="rois">[in] Face rects (must be pre-detected with OpenCV or DLib)</param>
+/// <param name="roisCount">[in] Number of face rects</param>
+/// <param name="output">[out] Landmarks as (x, y) int pairs, face after face</param>
+/// <param name="outputLength">[in] Output buffer length in ints, must fit roisCount * numParts * 2</param>
+/// <param name="offsets">[out] If non-null, receives roisCount indices of each face first point in the output (in points)</param>
+/// <returns>Number of points written, -1 if any argument is invalid (null predictor, image, rois or output, empty image,
+/// unsupported image type, negative roisCount or too small output buffer)</returns>
+CVAPI(int) dlib_shapePredictor_detectLandmarksBatch(dlib::shape_predictor* predictor, cv::Mat* image, MyCvRect* rois, int roisCount, int* output, int outputLength, int* offsets)
+{
+	if (nullptr == predictor || nullptr == image || image->empty() || roisCount < 0)
+		return -1;
+
+	const int type = image->type();
+	if (type != CV_8UC1 && type != CV_8UC3 && type != CV_8UC4)
+		return -1;
+	if (0 == roisCount)
+		return 0;
+
+	const int parts = (int)predictor->num_parts();
+	if (nullptr == rois || nullptr == output || (int64)outputLength < (int64)roisCount * parts * 2)
+		return -1;
+
+	if (nullptr != offsets)
+	{
+		for (int i = 0; i < roisCount; ++i)
+			offsets[i] = i * parts;
+	}
+
+	switch (type)
+	{
+	case CV_8UC1:	dlib_landmarks_batch<unsigned char>(*predictor, *image, rois, roisCount, output); break;
+	case CV_8UC3:	dlib_landmarks_batch<dlib::bgr_pixel>(*predictor, *image, rois, roisCount, output); break;
+	case CV_8UC4:	dlib_landmarks_batch<dlib::rgb_alpha_pixel>(*predictor, *image, rois, roisCount, output); break;
+	}
+
+	return roisCount * parts;
+}
+
+/// <summary>
+/// Releases dlib::shape_detector, shared predictors are released once the last handle is gone
 /// </summary>
 CVAPI(void) dlib_shapePredictor_delete(dlib::shape_predictor* object)
 {
-	delete object;
+	if (!ShapePredictorCache::instance().release(object))
+		delete object;
+}
+
+//------------------------------------------------------------------------------------------------------
+// DLib HOG frontal face detector
+//------------------------------------------------------------------------------------------------------
+
+/// <summary>
+/// Allocates new face detector
+/// </summary>
+/// <param name="threads">[in] Number of detector copies, i.e. max pyramid levels scanned in parallel, 0 to match cv::getNumThreads()</param>
+CVAPI(FaceDetector*) dlib_faceDetector_new(int threads)
+{
+	return new FaceDetector(threads);
+}
+
+/// <summary>
+/// Sets detection parameters
+/// </summary>
+/// <param name="upsample">[in] Number of times the image is upsampled 2x before scanning, finds faces smaller than 80x80</param>
+/// <param name="minFaceSize">[in] Smaller faces are not searched for, pyramid levels for them are skipped; 0 to search down to
+/// the smallest size upsample allows (80 / 2^upsample), 80 and above cancel upsample</param>
+/// <param name="pyramidDownscale">[in] Scale between pyramid levels, (0, 1), dlib uses 5/6 by default</param>
+/// <param name="adjustThreshold">[in] Detection threshold adjustment, negative values give more (less confident) detections</param>
+CVAPI(void) dlib_faceDetector_setParams(FaceDetector* detector, int upsample, int minFaceSize, double pyramidDownscale, double adjustThreshold)
+{
+	detector->upsample = std::max(0, upsample);
+	detector->minFaceSize = minFaceSize;
+	detector->pyramidDownscale = pyramidDownscale;
+	detector->adjustThreshold = adjustThreshold;
+}
+
+/// <summary>
+/// Detects faces in image
+/// </summary>
+/// <param name="image">[in] 8-bit grayscale or BGR image</param>
+/// <param name="results">[out] Detections ordered by confidence, owned by the detector and valid until the next detect call</param>
+/// <returns>Number of detections</returns>
+CVAPI(int) dlib_faceDetector_detect(FaceDetector* detector, cv::Mat* image, dlib_FaceDetection** results)
+{
+	const std::vector<dlib_FaceDetection> &ret = detector->detect(*image);
+	*results = ret.empty() ? nullptr : const_cast<dlib_FaceDetection*>(ret.data());
+	return (int)ret.size();
+}
+
+/// <summary>
+/// Releases face detector
+/// </summary>
+CVAPI(void) dlib_faceDetector_delete(FaceDetector* detector)
+{
+	delete detector;
 }
 
 #endif // _CPP_DLIB_H_
\ No newline at end of file
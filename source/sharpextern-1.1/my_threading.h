@@ -0,0 +1,79 @@
+// Additional threading primitives
+
+#ifndef _MY_THREADING_H_
+#define _MY_THREADING_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+/// <summary>
+/// Lock-free triple buffer for a single producer and a single consumer: producer always has a slot to write into,
+/// consumer always reads the latest completely written one, neither of them ever waits for the other
+/// </summary>
+template <typename T>
+class TripleBuffer
+{
+public:
+	TripleBuffer()
+		: back(0), middle(1), front(2)
+	{}
+
+	/// <summary>
+	/// Producer: slot to write the next item into
+	/// </summary>
+	T& writeBuffer()
+	{
+		return buffers[back];
+	}
+
+	/// <summary>
+	/// Producer: publishes written slot, the previously published one (if not consumed yet) is recycled
+	/// </summary>
+	void publish()
+	{
+		back = middle.exchange(back | fresh) & index;
+	}
+
+	/// <summary>
+	/// Consumer: checks whether there is a published item not yet acquired
+	/// </summary>
+	bool hasFresh() const
+	{
+		return 0 != (middle.load() & fresh);
+	}
+
+	/// <summary>
+	/// Consumer: takes the latest published item, if any
+	/// </summary>
+	/// <returns>True if new item has been acquired, false if readBuffer() still holds the previous one</returns>
+	bool acquire()
+	{
+		if (!hasFresh())
+			return false;
+
+		front = middle.exchange(front) & index;
+		return true;
+	}
+
+	/// <summary>
+	/// Consumer: the latest acquired item
+	/// </summary>
+	T& readBuffer()
+	{
+		return buffers[front];
+	}
+
+private:
+	static const int index = 3;
+	static const int fresh = 4;
+
+	T buffers[3];
+	int back;
+	std::atomic<int> middle;
+	int front;
+};
+
+#endif
@@ -123,6 +123,37 @@ extern "C"
         double errorCorrectionRate;
     };
 
+    struct aruco_MarkerPose
+    {
+        int id;
+        double rvec[3];                     // smoothed rotation (Rodrigues) vector
+        double tvec[3];                     // smoothed translation, marker length units
+        double reprojError;                 // RMS reprojection error of the raw pose, pixels
+    };
+
+    struct tracking_TrackedObject
+    {
+        int id;
+        int ok;                             // bool, failed tracks are dropped after being reported
+        MyCvRect2D rect;
+    };
+
+    struct video_TrackedFeature
+    {
+        int id;
+        MyCvPoint2D32f pt;
+        int status;                         // 0 - lost (reported once, then dropped), 1 - tracked, 2 - seeded on this frame
+        int age;                            // frames tracked since seeding
+    };
+
+    struct video_DenseFlowTimings
+    {
+        double downscale;                   // grayscale conversion and pyramid reduction, milliseconds
+        double flow;                        // flow at the reduced resolution
+        double upsample;                    // upsampling to the full resolution
+        double total;
+    };
+
     typedef struct CvVec2b { uchar val[2]; } CvVec2b;
     typedef struct CvVec3b { uchar val[3]; } CvVec3b;
     typedef struct CvVec4b { uchar val[4]; } CvVec4b;
@@ -147,6 +178,43 @@ extern "C"
     typedef struct CvVec3d { double val[3]; } CvVec3d;
     typedef struct CvVec4d { double val[4]; } CvVec4d;
     typedef struct CvVec6d { double val[6]; } CvVec6d;
+
+    struct dlib_FaceDetection
+    {
+        MyCvRect rect;
+        double confidence;
+        int weightIndex;                    // frontal face detector sub-detector (pose) index
+    };
+
+    struct objdetect_CascadeDetection
+    {
+        MyCvRect face;
+        MyCvRect eyes[2];                   // left to right, valid up to eyesCount
+        int eyesCount;
+        int confirmed;                      // bool
+    };
+
+    struct utils_FramePipelineResult
+    {
+        int64 frameId;
+        double processingTime;              // ms
+        int facesCount;
+        MyCvRect *faces;                    // [facesCount]
+        int partsPerFace;
+        CvVec2i *landmarks;                 // [facesCount * partsPerFace]
+        int markersCount;
+        int *markerIds;                     // [markersCount]
+        MyCvPoint2D32f *markerCorners;      // [markersCount * 4]
+        int error;                          // bool, the frame could not be processed (frameId is -1 then)
+    };
+
+    struct utils_BackgroundRunnerResult
+    {
+        int64 frameId;
+        double processingTime;              // ms, conversion and subtraction
+        double waitTime;                    // ms, from submission to the processing start
+        int error;                          // bool, the frame could not be processed (frameId is -1 then)
+    };
 }
 
 
@@ -1,2 +1,3 @@
 #include "objdetect.h"
-#include "objdetect_HOGDescriptor.h"
\ No newline at end of file
+#include "objdetect_HOGDescriptor.h"
+#include "objdetect_CascadeDetector.h"
\ No newline at end of file
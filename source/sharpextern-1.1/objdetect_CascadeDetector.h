@@ -0,0 +1,448 @@
+#ifndef _CPP_OBJDETECT_CASCADEDETECTOR_H_
+#define _CPP_OBJDETECT_CASCADEDETECTOR_H_
+
+#include "include_opencv.h"
+
+#include <mutex>
+
+//------------------------------------------------------------------------------------------------------
+// Cascade detector
+//
+// Faces + eyes detector built on top of cv::CascadeClassifier. cv::CascadeClassifier keeps per-call
+// state and can't be shared between threads, so the detector owns N clones of each cascade and runs
+// per-face passes in parallel, each parallel stripe borrowing its own clone.
+//
+// Tracking mode remembers faces found on the previous frame and searches only expanded ROIs around them
+// within a narrow scale band, full frame is re-scanned every rescanInterval frames or once any face is lost
+//------------------------------------------------------------------------------------------------------
+
+#pragma region CascadeDetector
+
+class CascadeDetector
+{
+public:
+	CascadeDetector(int threads)
+		: faceScaleFactor(1.2), faceMinNeighbors(6), faceMinSize(0, 0), faceMaxSize(0, 0),
+		  eyesScaleFactor(1.1), eyesMinNeighbors(3), eyesMinSize(0, 0), minEyes(1), maxEyes(2), rejectUnconfirmed(true),
+		  rescanInterval(10), roiExpand(0.5), scaleBand(1.25), framesSinceScan(0)
+	{
+		if (threads <= 0)
+			threads = std::max(1, cv::getNumThreads());
+
+		faceCascades.resize(threads);
+		eyesCascades.resize(threads);
+		for (int i = threads - 1; i >= 0; --i)
+			freeSlots.push_back(i);
+	}
+
+	/// <summary>
+	/// Loads face cascade into every clone
+	/// </summary>
+	bool readFaceCascade(const cv::FileNode &node)
+	{
+		return readCascades(faceCascades, node);
+	}
+	bool loadFaceCascade(const cv::String &fileName)
+	{
+		return loadCascades(faceCascades, fileName);
+	}
+
+	/// <summary>
+	/// Loads eyes cascade into every clone, eyes confirmation is skipped while there is none
+	/// </summary>
+	bool readEyesCascade(const cv::FileNode &node)
+	{
+		return readCascades(eyesCascades, node);
+	}
+	bool loadEyesCascade(const cv::String &fileName)
+	{
+		return loadCascades(eyesCascades, fileName);
+	}
+
+	bool hasFaceCascade() const
+	{
+		return !faceCascades[0].empty();
+	}
+	bool hasEyesCascade() const
+	{
+		return !eyesCascades[0].empty();
+	}
+
+	int getThreads() const
+	{
+		return (int)faceCascades.size();
+	}
+
+	/// <summary>
+	/// Full frame detection: faces over the whole image, then parallel eyes pass per face
+	/// </summary>
+	/// <param name="image">8-bit grayscale image, any normalization (equalizeHist etc.) is up to the caller</param>
+	const std::vector<objdetect_CascadeDetection>& detect(const cv::Mat &image)
+	{
+		// cascade parallelizes full frame detection internally
+		faceCascades[0].detectMultiScale(image, faces, faceScaleFactor, faceMinNeighbors, 0, faceMinSize, faceMaxSize);
+
+		confirm(image, faces, results);
+		return results;
+	}
+
+	/// <summary>
+	/// Fills detection records for the given face rects, runs eyes confirmation in parallel across faces
+	/// and drops unconfirmed faces if rejectUnconfirmed is set
+	/// </summary>
+	void confirm(const cv::Mat &image, const std::vector<cv::Rect> &rects, std::vector<objdetect_CascadeDetection> &output)
+	{
+		output.resize(rects.size());
+		for (size_t i = 0; i < rects.size(); ++i)
+		{
+			objdetect_CascadeDetection &d = output[i];
+			d.face = c(rects[i]);
+			d.eyes[0] = d.eyes[1] = c(cv::Rect());
+			d.eyesCount = 0;
+			d.confirmed = 1;
+		}
+
+		if (hasEyesCascade() && !rects.empty())
+		{
+			parallelFaces((int)rects.size(), [&](cv::CascadeClassifier &faceCascade, cv::CascadeClassifier &eyesCascade, int i) {
+				detectEyes(eyesCascade, image, rects[i], output[i]);
+			});
+
+			if (rejectUnconfirmed)
+			{
+				output.erase(std::remove_if(output.begin(), output.end(), [](const objdetect_CascadeDetection &d) {
+					return 0 == d.confirmed;
+				}), output.end());
+			}
+		}
+	}
+
+	/// <summary>
+	/// Tracking detection: searches previous frame faces in their neighborhood, falls back to the full frame
+	/// scan when it's time to rescan or when any of the faces is lost
+	/// </summary>
+	/// <param name="image">8-bit grayscale image</param>
+	/// <param name="fullScan">[out] True if the whole frame has been scanned</param>
+	const std::vector<objdetect_CascadeDetection>& track(const cv::Mat &image, bool &fullScan)
+	{
+		fullScan = tracks.empty() || rescanInterval <= 1 || framesSinceScan + 1 >= rescanInterval || !trackInRois(image);
+		if (fullScan)
+		{
+			detect(image);
+			framesSinceScan = 0;
+		}
+		else
+		{
+			confirm(image, tracked, results);
+			++framesSinceScan;
+
+			// face rejected by eyes is as good as lost
+			if (results.size() < tracked.size())
+				framesSinceScan = rescanInterval;
+		}
+
+		// what's left is the state for the next frame
+		tracks.resize(results.size());
+		for (size_t i = 0; i < results.size(); ++i)
+			tracks[i] = cpp(results[i].face);
+
+		return results;
+	}
+
+	/// <summary>
+	/// Forgets tracked faces, the next track() scans the full frame
+	/// </summary>
+	void resetTracking()
+	{
+		tracks.clear();
+		framesSinceScan = 0;
+	}
+
+protected:
+	/// <summary>
+	/// Searches every tracked face inside its expanded ROI, in parallel across faces
+	/// </summary>
+	/// <returns>False if any face has been lost</returns>
+	bool trackInRois(const cv::Mat &image)
+	{
+		tracked.resize(tracks.size());
+		lost.assign(tracks.size(), 0);
+
+		cv::Rect frame(0, 0, image.cols, image.rows);
+		parallelFaces((int)tracks.size(), [&](cv::CascadeClassifier &faceCascade, cv::CascadeClassifier &eyesCascade, int i) {
+			const cv::Rect &prev = tracks[i];
+			int dx = cvRound(prev.width * roiExpand), dy = cvRound(prev.height * roiExpand);
+			cv::Rect roi = cv::Rect(prev.x - dx, prev.y - dy, prev.width + 2 * dx, prev.height + 2 * dy) & frame;
+
+			// faces don't change size much between frames: a narrow band of scales around the previous one
+			cv::Size minSize(cvFloor(prev.width / scaleBand), cvFloor(prev.height / scaleBand));
+			cv::Size maxSize(cvCeil(prev.width * scaleBand), cvCeil(prev.height * scaleBand));
+			maxSize.width = std::min(maxSize.width, roi.width);
+			maxSize.height = std::min(maxSize.height, roi.height);
+
+			std::vector<cv::Rect> found;
+			if (roi.area() > 0)
+				faceCascade.detectMultiScale(image(roi), found, faceScaleFactor, faceMinNeighbors, 0, minSize, maxSize);
+			if (found.empty())
+			{
+				lost[i] = 1;
+				return;
+			}
+
+			// the closest one to the previous position
+			cv::Point center = (prev.tl() + prev.br()) * 0.5 - roi.tl();
+			size_t best = 0;
+			double bestDistance = DBL_MAX;
+			for (size_t j = 0; j < found.size(); ++j)
+			{
+				cv::Point d = (found[j].tl() + found[j].br()) * 0.5 - center;
+				double distance = d.ddot(d);
+				if (distance < bestDistance)
+				{
+					bestDistance = distance;
+					best = j;
+				}
+			}
+			tracked[i] = found[best] + roi.tl();
+		});
+
+		return std::find(lost.begin(), lost.end(), 1) == lost.end();
+	}
+
+	/// <summary>
+	/// Runs body(faceCascade, eyesCascade, index) for each of count items, in parallel stripes no more than
+	/// cascade clones available
+	/// </summary>
+	template<typename Body>
+	void parallelFaces(int count, const Body &body)
+	{
+		int stripes = std::min(count, (int)faceCascades.size());
+		cv::parallel_for_(cv::Range(0, count), FacesInvoker<Body>(*this, body), stripes);
+	}
+
+	/// <summary>
+	/// Eyes search inside the face rect, eyes are returned in image coordinates ordered left to right
+	/// </summary>
+	void detectEyes(cv::CascadeClassifier &cascade, const cv::Mat &image, const cv::Rect &face, objdetect_CascadeDetection &result) const
+	{
+		std::vector<cv::Rect> eyes;
+		cv::Rect roi = face & cv::Rect(0, 0, image.cols, image.rows);
+		cascade.detectMultiScale(image(roi), eyes, eyesScaleFactor, eyesMinNeighbors, 0, eyesMinSize);
+
+		std::sort(eyes.begin(), eyes.end(), [](const cv::Rect &a, const cv::Rect &b) { return a.x < b.x; });
+		for (size_t j = 0; j < eyes.size() && j < 2; ++j)
+			result.eyes[j] = c(eyes[j] + roi.tl());
+
+		result.eyesCount = (int)eyes.size();
+		result.confirmed = (result.eyesCount >= minEyes && result.eyesCount <= maxEyes) ? 1 : 0;
+	}
+
+private:
+	template<typename Body>
+	class FacesInvoker : public cv::ParallelLoopBody
+	{
+	public:
+		FacesInvoker(CascadeDetector &owner, const Body &body)
+			: owner(owner), body(body)
+		{}
+
+		virtual void operator() (const cv::Range &range) const
+		{
+			int slot = owner.acquireSlot();
+			for (int i = range.start; i < range.end; ++i)
+				body(owner.faceCascades[slot], owner.eyesCascades[slot], i);
+			owner.releaseSlot(slot);
+		}
+
+	private:
+		CascadeDetector &owner;
+		const Body &body;
+	};
+
+	/// <summary>
+	/// Takes cascade clone index not used by any other stripe, there are never more stripes than clones
+	/// </summary>
+	int acquireSlot()
+	{
+		std::lock_guard<std::mutex> lock(slotsMutex);
+		int slot = freeSlots.back();
+		freeSlots.pop_back();
+		return slot;
+	}
+	void releaseSlot(int slot)
+	{
+		std::lock_guard<std::mutex> lock(slotsMutex);
+		freeSlots.push_back(slot);
+	}
+
+	static bool readCascades(std::vector<cv::CascadeClassifier> &cascades, const cv::FileNode &node)
+	{
+		for (size_t i = 0; i < cascades.size(); ++i)
+		{
+			if (!cascades[i].read(node))
+				return false;
+		}
+		return true;
+	}
+
+	static bool loadCascades(std::vector<cv::CascadeClassifier> &cascades, const cv::String &fileName)
+	{
+		for (size_t i = 0; i < cascades.size(); ++i)
+		{
+			if (!cascades[i].load(fileName))
+				return false;
+		}
+		return true;
+	}
+
+public:
+	// faces
+	double faceScaleFactor;
+	int faceMinNeighbors;
+	cv::Size faceMinSize;
+	cv::Size faceMaxSize;
+
+	// eyes
+	double eyesScaleFactor;
+	int eyesMinNeighbors;
+	cv::Size eyesMinSize;
+	int minEyes;
+	int maxEyes;
+	bool rejectUnconfirmed;
+
+	// tracking
+	int rescanInterval;
+	double roiExpand;
+	double scaleBand;
+
+protected:
+	std::vector<cv::CascadeClassifier> faceCascades;
+	std::vector<cv::CascadeClassifier> eyesCascades;
+
+	// re-used between frames
+	std::vector<cv::Rect> faces;
+	std::vector<objdetect_CascadeDetection> results;
+
+	// tracking state
+	std::vector<cv::Rect> tracks;
+	std::vector<cv::Rect> tracked;
+	std::vector<char> lost;
+	int framesSinceScan;
+
+private:
+	std::mutex slotsMutex;
+	std::vector<int> freeSlots;
+};
+
+//------------------------------------------------------------------------------------------------------
+// C-wrapper
+//------------------------------------------------------------------------------------------------------
+
+/// <summary>
+/// Creates detector with the given number of cascade clones, 0 to match cv::getNumThreads()
+/// </summary>
+CVAPI(CascadeDetector*) objdetect_CascadeDetector_new(int threads)
+{
+	return new CascadeDetector(threads);
+}
+
+CVAPI(void) objdetect_CascadeDetector_delete(CascadeDetector *obj)
+{
+	delete obj;
+}
+
+CVAPI(int) objdetect_CascadeDetector_getThreads(CascadeDetector *obj)
+{
+	return obj->getThreads();
+}
+
+CVAPI(int) objdetect_CascadeDetector_readFaceCascade(CascadeDetector *obj, const cv::FileNode *node)
+{
+	return obj->readFaceCascade(*node) ? 1 : 0;
+}
+CVAPI(int) objdetect_CascadeDetector_loadFaceCascade(CascadeDetector *obj, const char *fileName)
+{
+	return obj->loadFaceCascade(fileName) ? 1 : 0;
+}
+
+CVAPI(int) objdetect_CascadeDetector_readEyesCascade(CascadeDetector *obj, const cv::FileNode *node)
+{
+	return obj->readEyesCascade(*node) ? 1 : 0;
+}
+CVAPI(int) objdetect_CascadeDetector_loadEyesCascade(CascadeDetector *obj, const char *fileName)
+{
+	return obj->loadEyesCascade(fileName) ? 1 : 0;
+}
+
+/// <summary>
+/// Face detection parameters, same meaning as for cv::CascadeClassifier::detectMultiScale
+/// </summary>
+CVAPI(void) objdetect_CascadeDetector_setFaceParams(CascadeDetector *obj, double scaleFactor, int minNeighbors, MyCvSize minSize, MyCvSize maxSize)
+{
+	obj->faceScaleFactor = scaleFactor;
+	obj->faceMinNeighbors = minNeighbors;
+	obj->faceMinSize = cpp(minSize);
+	obj->faceMaxSize = cpp(maxSize);
+}
+
+/// <summary>
+/// Eyes confirmation parameters: face is confirmed if eyes count is within [minEyes, maxEyes]
+/// </summary>
+CVAPI(void) objdetect_CascadeDetector_setEyesParams(CascadeDetector *obj, double scaleFactor, int minNeighbors, MyCvSize minSize, int minEyes, int maxEyes, int rejectUnconfirmed)
+{
+	obj->eyesScaleFactor = scaleFactor;
+	obj->eyesMinNeighbors = minNeighbors;
+	obj->eyesMinSize = cpp(minSize);
+	obj->minEyes = minEyes;
+	obj->maxEyes = maxEyes;
+	obj->rejectUnconfirmed = rejectUnconfirmed != 0;
+}
+
+/// <summary>
+/// Detects faces and confirms them with eyes
+/// </summary>
+/// <param name="image">[in] 8-bit grayscale image</param>
+/// <param name="results">[out] Detections array, owned by the detector and valid until the next detect call</param>
+/// <returns>Number of detections</returns>
+CVAPI(int) objdetect_CascadeDetector_detect(CascadeDetector *obj, cv::Mat *image, objdetect_CascadeDetection **results)
+{
+	const std::vector<objdetect_CascadeDetection> &ret = obj->detect(*image);
+	*results = ret.empty() ? nullptr : const_cast<objdetect_CascadeDetection*>(ret.data());
+	return (int)ret.size();
+}
+
+/// <summary>
+/// Tracking mode parameters
+/// </summary>
+/// <param name="rescanInterval">Full frame is scanned every rescanInterval frames, 1 to scan every frame</param>
+/// <param name="roiExpand">Search ROI is the previous face rect expanded by roiExpand of its size at every side</param>
+/// <param name="scaleBand">Searched face sizes are within [previous / scaleBand, previous * scaleBand]</param>
+CVAPI(void) objdetect_CascadeDetector_setTrackingParams(CascadeDetector *obj, int rescanInterval, double roiExpand, double scaleBand)
+{
+	obj->rescanInterval = rescanInterval;
+	obj->roiExpand = roiExpand;
+	obj->scaleBand = std::max(1.0, scaleBand);
+}
+
+/// <summary>
+/// Detects faces using previous frame results, see objdetect_CascadeDetector_detect
+/// </summary>
+/// <param name="fullScan">[out] 1 if the whole frame has been scanned this time, 0 if only tracked ROIs</param>
+/// <returns>Number of detections</returns>
+CVAPI(int) objdetect_CascadeDetector_track(CascadeDetector *obj, cv::Mat *image, objdetect_CascadeDetection **results, int *fullScan)
+{
+	bool scanned = false;
+	const std::vector<objdetect_CascadeDetection> &ret = obj->track(*image, scanned);
+	*results = ret.empty() ? nullptr : const_cast<objdetect_CascadeDetection*>(ret.data());
+	*fullScan = scanned ? 1 : 0;
+	return (int)ret.size();
+}
+
+CVAPI(void) objdetect_CascadeDetector_resetTracking(CascadeDetector *obj)
+{
+	obj->resetTracking();
+}
+
+#pragma endregion
+
+#endif
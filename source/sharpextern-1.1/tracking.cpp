@@ -1 +1,2 @@
-#include "tracking.h"
\ No newline at end of file
+#include "tracking.h"
+#include "tracking_MultiObjectTracker.h"
\ No newline at end of file
@@ -0,0 +1,189 @@
+#ifndef _CPP_TRACKING_MULTIOBJECTTRACKER_H_
+#define _CPP_TRACKING_MULTIOBJECTTRACKER_H_
+
+#include "include_opencv.h"
+
+//------------------------------------------------------------------------------------------------------
+// Multi-object tracker
+//
+// Owns a set of cv::Tracker instances (of any types) and updates all of them against the same frame
+// within a single call, in parallel: trackers don't share state, so each one is a separate parallel
+// stripe. Tracks that failed to update are reported once and dropped
+//------------------------------------------------------------------------------------------------------
+
+#pragma region MultiObjectTracker
+
+class MultiObjectTracker
+{
+public:
+	MultiObjectTracker()
+		: nextId(0)
+	{}
+
+	/// <summary>
+	/// Creates and initializes a new tracker
+	/// </summary>
+	/// <param name="type">Tracker type name, as for cv::Tracker::create</param>
+	/// <returns>Track id, -1 if tracker failed to create or initialize</returns>
+	int add(const cv::String &type, const cv::Mat &image, const cv::Rect2d &boundingBox)
+	{
+		cv::Ptr<cv::Tracker> tracker = cv::Tracker::create(type);
+		if (tracker.empty() || !tracker->init(image, boundingBox))
+			return -1;
+
+		Track track;
+		track.id = nextId++;
+		track.tracker = tracker;
+		track.rect = boundingBox;
+		tracks.push_back(track);
+		return track.id;
+	}
+
+	/// <summary>
+	/// Removes track
+	/// </summary>
+	/// <returns>False if there is no such track</returns>
+	bool remove(int id)
+	{
+		for (size_t i = 0; i < tracks.size(); ++i)
+		{
+			if (tracks[i].id == id)
+			{
+				tracks.erase(tracks.begin() + i);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void clear()
+	{
+		tracks.clear();
+	}
+
+	int size() const
+	{
+		return (int)tracks.size();
+	}
+
+	/// <summary>
+	/// Updates all the tracks, failed ones are included into the results and dropped afterwards
+	/// </summary>
+	const std::vector<tracking_TrackedObject>& update(const cv::Mat &image)
+	{
+		results.resize(tracks.size());
+		cv::parallel_for_(cv::Range(0, (int)tracks.size()), UpdateInvoker(tracks, image, results));
+
+		size_t alive = 0;
+		for (size_t i = 0; i < tracks.size(); ++i)
+		{
+			if (results[i].ok)
+			{
+				if (alive != i)
+					tracks[alive] = tracks[i];
+				++alive;
+			}
+		}
+		tracks.resize(alive);
+
+		return results;
+	}
+
+private:
+	struct Track
+	{
+		int id;
+		cv::Ptr<cv::Tracker> tracker;
+		cv::Rect2d rect;
+	};
+
+	class UpdateInvoker : public cv::ParallelLoopBody
+	{
+	public:
+		UpdateInvoker(std::vector<Track> &tracks, const cv::Mat &image, std::vector<tracking_TrackedObject> &results)
+			: tracks(tracks), image(image), results(results)
+		{}
+
+		virtual void operator() (const cv::Range &range) const
+		{
+			for (int i = range.start; i < range.end; ++i)
+			{
+				Track &track = tracks[i];
+				bool ok = track.tracker->update(image, track.rect);
+
+				tracking_TrackedObject &result = results[i];
+				result.id = track.id;
+				result.ok = ok ? 1 : 0;
+				result.rect = c(track.rect);
+			}
+		}
+
+	private:
+		std::vector<Track> &tracks;
+		const cv::Mat &image;
+		std::vector<tracking_TrackedObject> &results;
+	};
+
+private:
+	int nextId;
+	std::vector<Track> tracks;
+	std::vector<tracking_TrackedObject> results;
+};
+
+//------------------------------------------------------------------------------------------------------
+// C-wrapper
+//------------------------------------------------------------------------------------------------------
+
+CVAPI(MultiObjectTracker*) tracking_MultiObjectTracker_new()
+{
+	return new MultiObjectTracker();
+}
+
+CVAPI(void) tracking_MultiObjectTracker_delete(MultiObjectTracker *obj)
+{
+	delete obj;
+}
+
+/// <summary>
+/// Creates new track
+/// </summary>
+/// <param name="trackerType">[in] Tracker type name, as for tracking_Tracker_create</param>
+/// <param name="image">[in] The initial frame</param>
+/// <param name="boundingBox">The initial bounding box</param>
+/// <returns>Track id, -1 if tracker failed to create or initialize</returns>
+CVAPI(int) tracking_MultiObjectTracker_add(MultiObjectTracker *obj, const char *trackerType, const cv::Mat *image, MyCvRect2D boundingBox)
+{
+	return obj->add(trackerType, *image, cpp(boundingBox));
+}
+
+CVAPI(int) tracking_MultiObjectTracker_remove(MultiObjectTracker *obj, int id)
+{
+	return obj->remove(id) ? 1 : 0;
+}
+
+CVAPI(void) tracking_MultiObjectTracker_clear(MultiObjectTracker *obj)
+{
+	obj->clear();
+}
+
+CVAPI(int) tracking_MultiObjectTracker_size(MultiObjectTracker *obj)
+{
+	return obj->size();
+}
+
+/// <summary>
+/// Updates all tracks against the frame in parallel, tracks failed to update are dropped
+/// </summary>
+/// <param name="image">[in] The current frame</param>
+/// <param name="results">[out] Tracks array (including the failed ones), owned by the tracker and valid until the next update call</param>
+/// <returns>Number of tracks updated</returns>
+CVAPI(int) tracking_MultiObjectTracker_update(MultiObjectTracker *obj, const cv::Mat *image, tracking_TrackedObject **results)
+{
+	const std::vector<tracking_TrackedObject> &ret = obj->update(*image);
+	*results = ret.empty() ? nullptr : const_cast<tracking_TrackedObject*>(ret.data());
+	return (int)ret.size();
+}
+
+#pragma endregion
+
+#endif
@@ -7,3 +7,6 @@
 //
 
 #include "utils.h"
+#include "utils_FramePipeline.h"
+#include "utils_LandmarkStabilizer.h"
+#include "utils_BackgroundRunner.h"
@@ -2,6 +2,9 @@
 #define _CPP_UTILS_H_
 
 #include "include_opencv.h"
+#include <opencv2/core/hal/intrin.hpp>
+
+#include <atomic>
 
 //////////////////////////////////////////////////////////////////////////
 // NOTE:
@@ -13,111 +16,855 @@
 // In order to make it stable we avoid in-place processing at all
 //////////////////////////////////////////////////////////////////////////
 
+//------------------------------------------------------------------------------------------------------
+// Auxiliary
+//------------------------------------------------------------------------------------------------------
+
 /// <summary>
-/// Converts raw pixel dtaa into cv::mat
+/// Minimal stripe height (in output rows) for the parallel conversion, images with less than two stripes are converted
+/// on the calling thread; atomic since it's changed from managed code while conversions might run on other threads
 /// </summary>
-/// <param name="pixels32">[in] Image pixels as RGBA 32-bit</param>
-/// <param name="w">Image width</param>
-/// <param name="h">Image height</param>
-/// <param name="flipVertically">True to flip image vertically (around X axis), false otherwise</param>
-/// <param name="flipHorizontally">True to flip image horizontally (around Y axis), false otherwise</param>
-/// <param name="rotationAngle">Image rotation angle in CCW direction, must be one of { -270, -180, -90, 0, 90, 180, 270 }</param>
-/// <returns>cv::Mat with image in OpenCV format</returns>
-CVAPI(cv::Mat*) utils_texture_to_mat(unsigned char *pixels32, int w, int h, bool flipVertically, bool flipHorizontally, int rotationAngle)
+static std::atomic<int> utils_minStripeHeight(64);
+
+/// <summary>
+/// cv::ParallelLoopBody adapter for the row-stripe functors
+/// </summary>
+template <typename Body>
+class StripeInvoker : public cv::ParallelLoopBody
 {
-	// [Referenced] input buffer, 4-channel RGBA
-	cv::Mat input(h, w, CV_8UC4, pixels32);
+public:
+	explicit StripeInvoker(const Body &body)
+		: body(body)
+	{}
+
+	virtual void operator()(const cv::Range &range) const
+	{
+		body(range);
+	}
 
-	// [Allocated, Stack] buffer, 3-channel BGR
-    cv::Mat bgr(h, w, CV_8UC3);
-    cv::cvtColor(input, bgr, CV_RGBA2BGR);
+private:
+	Body body;
+};
 
-	// [Allocated, Heap] output buffer, 3-channel BGR, transformed
-	cv::Mat* output = new cv::Mat(h, w, CV_8UC3);
+/// <summary>
+/// Runs body over the rows range split into stripes with cv::parallel_for_, stripes count is limited
+/// by both minimal stripe height and cv::getNumThreads() (so it honours core_setNumThreads)
+/// </summary>
+/// <param name="rows">Total rows count</param>
+/// <param name="body">Functor accepting cv::Range of rows to process</param>
+template <typename Body>
+static void utils_parallel_rows(int rows, const Body &body)
+{
+	const int stripes = std::min(cv::getNumThreads(), rows / std::max(1, utils_minStripeHeight.load()));
+	if (stripes > 1)
+		cv::parallel_for_(cv::Range(0, rows), StripeInvoker<Body>(body), stripes);
+	else
+		body(cv::Range(0, rows));
+}
 
-	// rotation:
+/// <summary>
+/// Resolves 90-degree step rotation into transposition + flips
+/// </summary>
+/// <param name="rotationAngle">Image rotation angle in CCW direction, must be one of { -270, -180, -90, 0, 90, 180, 270 }</param>
+/// <param name="flipVertically">[in, out] Vertical flip flag, updated with the rotation</param>
+/// <param name="flipHorizontally">[in, out] Horizontal flip flag, updated with the rotation</param>
+/// <returns>True if image must be transposed before the flips are applied</returns>
+static bool utils_resolve_rotation(int rotationAngle, bool &flipVertically, bool &flipHorizontally)
+{
 	// since we have 90-degree step, we actually do not rotate
-	// image, but transpose + flip it, the last one is delayed
-	// as we have flip params to process as a separate step
+	// image, but transpose + flip it
 	switch (rotationAngle)
 	{
 	case 90:
 	case -270:
-		bgr = bgr.t();
 		flipVertically = !flipVertically;
-		break;
+		return true;
 
 	case 180:
 	case -180:
 		flipVertically = !flipVertically;
 		flipHorizontally = !flipHorizontally;
-		break;
+		return false;
 
 	case 270:
 	case -90:
-		bgr = bgr.t();
 		flipHorizontally = !flipHorizontally;
-		break;
+		return true;
 	}
-    
-	// flip
-	if (flipVertically || flipHorizontally)
+
+	return false;
+}
+
+#if CV_SIMD128
+/// <summary>
+/// Reverses order of the vector lanes
+/// </summary>
+static inline cv::v_uint8x16 utils_v_reverse(const cv::v_uint8x16 &a)
+{
+#if CV_SSSE3
+	return cv::v_uint8x16(_mm_shuffle_epi8(a.val, _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)));
+#elif CV_NEON
+	uint8x16_t r = vrev64q_u8(a.val);
+	return cv::v_uint8x16(vcombine_u8(vget_high_u8(r), vget_low_u8(r)));
+#else
+	uchar buf[16];
+	cv::v_store(buf, a);
+	std::reverse(buf, buf + 16);
+	return cv::v_load(buf);
+#endif
+}
+#endif
+
+/// <summary>
+/// Converts one row of RGBA pixels into BGR ones, source might be read backwards (mirrored)
+/// </summary>
+/// <param name="s">[in] Source pixel for the first output pixel</param>
+/// <param name="d">[out] Output row</param>
+/// <param name="cols">Pixels count</param>
+/// <param name="mirror">True if source row must be read backwards</param>
+static void utils_rgba_to_bgr_row(const uchar *s, uchar *d, int cols, bool mirror)
+{
+	int c = 0;
+
+#if CV_SIMD128
+	cv::v_uint8x16 r, g, b, a;
+	if (!mirror)
 	{
-		// OpenCV flip codes are { 0 -> flip vertically, 1+ (any positive) -> flip horizontally, -1 -> flip both }
-		int flipCode = (flipVertically && flipHorizontally) ? -1 : (flipVertically ? 0 : 1);
-		cv::flip(bgr, *output, flipCode);
+		for (; c <= cols - 16; c += 16, s += 64, d += 48)
+		{
+			cv::v_load_deinterleave(s, r, g, b, a);
+			cv::v_store_interleave(d, b, g, r);
+		}
 	}
-	// or simply assign without flip
 	else
 	{
-		*output = bgr;
+		// 16 source pixels end at s, so we load them as is and reverse lanes
+		for (; c <= cols - 16; c += 16, s -= 64, d += 48)
+		{
+			cv::v_load_deinterleave(s - 60, r, g, b, a);
+			cv::v_store_interleave(d, utils_v_reverse(b), utils_v_reverse(g), utils_v_reverse(r));
+		}
+	}
+#endif
+
+	const ptrdiff_t ds = mirror ? -4 : 4;
+	for (; c < cols; ++c, s += ds, d += 3)
+	{
+		d[0] = s[2];
+		d[1] = s[1];
+		d[2] = s[0];
 	}
-    
-	// we're good
-    return output;
 }
 
-// colorConversionCode expected to convert mat color to RGBA color that is Unity color space
-CVAPI(cv::Mat*) utils_mat_to_texture_1(cv::Mat *mat, int colorConversionCode)
+/// <summary>
+/// Converts RGBA image into BGR one applying transposition and flips in a single pass,
+/// each output pixel is read right from its final source position, so no intermediate images are required
+/// (transposed blocks only pass through a small per-tile buffer on stack)
+/// </summary>
+/// <param name="src">[in] Source image, 4-channel RGBA</param>
+/// <param name="dst">[out] Destination image, 3-channel BGR, must be allocated with already transposed size</param>
+/// <param name="transpose">True to transpose image</param>
+/// <param name="flipVertically">True to flip (transposed) image vertically</param>
+/// <param name="flipHorizontally">True to flip (transposed) image horizontally</param>
+/// <param name="range">Output rows to process</param>
+static void utils_rgba_to_bgr_transformed(const cv::Mat &src, cv::Mat &dst, bool transpose, bool flipVertically, bool flipHorizontally, const cv::Range &range)
 {
-	// Reverse of utils_texture_to_mat algorithm
-	cv::Mat *output = new cv::Mat(mat->size(), CV_8UC4);
+	const int rows = dst.rows;
+	const int cols = dst.cols;
 
-	// #0 trial marker
+	// regular image: every output row is a (maybe mirrored) source row, so it's vectorized row by row
+	if (!transpose)
+	{
+		for (int r = range.start; r < range.end; ++r)
+		{
+			const uchar *s = src.ptr(flipVertically ? rows - 1 - r : r);
+			utils_rgba_to_bgr_row(flipHorizontally ? s + (cols - 1) * 4 : s, dst.ptr(r), cols, flipHorizontally);
+		}
+		return;
+	}
+
+	// transposed image: every output row is a source column, walking whole columns would touch
+	// new cache line on each pixel, so the image is processed by square tiles that fit into L1
+	const int tile = 32;
+	const ptrdiff_t step = flipHorizontally ? -(ptrdiff_t)src.step : (ptrdiff_t)src.step;
+	for (int r0 = range.start; r0 < range.end; r0 += tile)
+	{
+		const int r1 = std::min(r0 + tile, range.end);
+		for (int c0 = 0; c0 < cols; c0 += tile)
+		{
+			const int c1 = std::min(c0 + tile, cols);
+			int r = r0;
+
+#if CV_SIMD128
+			// 4 output rows at a time: 4x4 pixel blocks are transposed in registers into RGBA rows buffer,
+			// then buffered rows are converted to BGR with the same vectorized code as regular image is
+			uchar buffer[4][tile * 4];
+			for (; r <= r1 - 4; r += 4)
+			{
+				// output rows r..r+3 are 4 adjacent source columns, backwards if flipped vertically
+				const int sr = flipVertically ? rows - 4 - r : r;
+				const int sc = flipHorizontally ? cols - 1 - c0 : c0;
+
+				const uchar *s = src.ptr(sc) + sr * 4;
+				int c = c0;
+				for (; c <= c1 - 4; c += 4, s += 4 * step)
+				{
+					cv::v_uint32x4 a0 = cv::v_load((const unsigned *)s);
+					cv::v_uint32x4 a1 = cv::v_load((const unsigned *)(s + step));
+					cv::v_uint32x4 a2 = cv::v_load((const unsigned *)(s + 2 * step));
+					cv::v_uint32x4 a3 = cv::v_load((const unsigned *)(s + 3 * step));
+					cv::v_uint32x4 b0, b1, b2, b3;
+					cv::v_transpose4x4(a0, a1, a2, a3, b0, b1, b2, b3);
+
+					// b0 holds the leftmost source column, which is the last output row on vertical flip
+					const int x = (c - c0) * 4;
+					cv::v_store((unsigned *)(buffer[flipVertically ? 3 : 0] + x), b0);
+					cv::v_store((unsigned *)(buffer[flipVertically ? 2 : 1] + x), b1);
+					cv::v_store((unsigned *)(buffer[flipVertically ? 1 : 2] + x), b2);
+					cv::v_store((unsigned *)(buffer[flipVertically ? 0 : 3] + x), b3);
+				}
+				for (; c < c1; ++c, s += step)
+				{
+					for (int i = 0; i < 4; ++i)
+						memcpy(buffer[flipVertically ? 3 - i : i] + (c - c0) * 4, s + i * 4, 4);
+				}
+
+				for (int i = 0; i < 4; ++i)
+					utils_rgba_to_bgr_row(buffer[i], dst.ptr(r + i) + c0 * 3, c1 - c0, false);
+			}
+#endif
+
+			for (; r < r1; ++r)
+			{
+				// output row r is the source column sr, output column c is the source row sc
+				const int sr = flipVertically ? rows - 1 - r : r;
+				const int sc = flipHorizontally ? cols - 1 - c0 : c0;
+
+				const uchar *s = src.ptr(sc) + sr * 4;
+				uchar *d = dst.ptr(r) + c0 * 3;
+				for (int c = c0; c < c1; ++c, s += step, d += 3)
+				{
+					d[0] = s[2];
+					d[1] = s[1];
+					d[2] = s[0];
+				}
+			}
+		}
+	}
+}
+
+/// <summary>
+/// Converts RGBA pixels into BGR cv::Mat applying rotation and flips, output is re-created only on size/type change
+/// </summary>
+/// <param name="input">[in] Source image, 4-channel RGBA</param>
+/// <param name="flipVertically">True to flip image vertically (around X axis), false otherwise</param>
+/// <param name="flipHorizontally">True to flip image horizontally (around Y axis), false otherwise</param>
+/// <param name="rotationAngle">Image rotation angle in CCW direction, must be one of { -270, -180, -90, 0, 90, 180, 270 }</param>
+/// <param name="output">[in, out] Output image, 3-channel BGR</param>
+/// <returns>True if output memory had to be (re-)allocated</returns>
+static bool utils_rgba_to_bgr(const cv::Mat &input, bool flipVertically, bool flipHorizontally, int rotationAngle, cv::Mat &output)
+{
+	bool transpose = utils_resolve_rotation(rotationAngle, flipVertically, flipHorizontally);
+
+	const uchar *data = output.data;
+	output.create(transpose ? input.cols : input.rows, transpose ? input.rows : input.cols, CV_8UC3);
+
+	// colour conversion, transposition and flips are done in one pass, output row stripes are processed in parallel
+	utils_parallel_rows(output.rows, [&](const cv::Range &range) {
+		utils_rgba_to_bgr_transformed(input, output, transpose, flipVertically, flipHorizontally, range);
+	});
+
+	return data != output.data;
+}
+
+/// <summary>
+/// Converts one YUV 4:2:0 pixel into BGR, BT.601 video range, same fixed-point math as cv::cvtColor does for COLOR_YUV2BGR_NV21 & Co.
+/// </summary>
+static inline void utils_yuv_to_bgr_pixel(int y, int u, int v, uchar *d)
+{
+	const int shift = 20;
+	const int round = 1 << (shift - 1);
+
+	const int yy = std::max(0, y - 16) * 1220542;
+	const int uu = u - 128;
+	const int vv = v - 128;
+
+	d[0] = cv::saturate_cast<uchar>((yy + 2116026 * uu + round) >> shift);
+	d[1] = cv::saturate_cast<uchar>((yy - 409993 * uu - 852492 * vv + round) >> shift);
+	d[2] = cv::saturate_cast<uchar>((yy + 1673527 * vv + round) >> shift);
+}
+
+/// <summary>
+/// YUV 4:2:0 frame planes description, covers NV12, NV21, I420 (YUV420p) and Android YUV_420_888 layouts
+/// </summary>
+struct UtilsYuvPlanes
+{
+	const uchar *y;			// luma plane
+	const uchar *u;			// first U sample
+	const uchar *v;			// first V sample
+	int yStride;			// luma row step, bytes
+	int uvStride;			// chroma row step, bytes
+	int uvPixelStride;		// distance between two chroma samples in a row: 2 for NV12/NV21, 1 for I420
+};
+
+/// <summary>
+/// Converts YUV 4:2:0 frame into BGR or grayscale image applying transposition and flips in a single pass
+/// </summary>
+/// <param name="src">[in] Source frame planes</param>
+/// <param name="dst">[out] Destination image, 3-channel BGR or 1-channel grayscale, must be allocated with already transposed size</param>
+/// <param name="transpose">True to transpose image</param>
+/// <param name="flipVertically">True to flip (transposed) image vertically</param>
+/// <param name="flipHorizontally">True to flip (transposed) image horizontally</param>
+/// <param name="range">Output rows to process</param>
+static void utils_yuv_transformed(const UtilsYuvPlanes &src, cv::Mat &dst, bool transpose, bool flipVertically, bool flipHorizontally, const cv::Range &range)
+{
+	const int rows = dst.rows;
+	const int cols = dst.cols;
+	const bool gray = (1 == dst.channels());
+
+	// output pixel (r, c) is the source one (x, y), where x (or y if transposed) walks one step per output column,
+	// transposed image is processed by tiles for the same reason utils_rgba_to_bgr_transformed does it
+	const int tile = transpose ? 32 : cols;
+	const int dc = flipHorizontally ? -1 : 1;
+	for (int r0 = range.start; r0 < range.end; r0 += tile)
+	{
+		const int r1 = std::min(r0 + tile, range.end);
+		for (int c0 = 0; c0 < cols; c0 += tile)
+		{
+			const int c1 = std::min(c0 + tile, cols);
+			for (int r = r0; r < r1; ++r)
+			{
+				const int sr = flipVertically ? rows - 1 - r : r;
+				int sc = flipHorizontally ? cols - 1 - c0 : c0;
+
+				uchar *d = dst.ptr(r) + c0 * dst.channels();
+				if (gray)
+				{
+					for (int c = c0; c < c1; ++c, sc += dc, ++d)
+						*d = transpose ? src.y[sc * src.yStride + sr] : src.y[sr * src.yStride + sc];
+					continue;
+				}
+
+				for (int c = c0; c < c1; ++c, sc += dc, d += 3)
+				{
+					const int x = transpose ? sr : sc;
+					const int y = transpose ? sc : sr;
+					const int uv = (y >> 1) * src.uvStride + (x >> 1) * src.uvPixelStride;
+					utils_yuv_to_bgr_pixel(src.y[y * src.yStride + x], src.u[uv], src.v[uv], d);
+				}
+			}
+		}
+	}
+}
+
+/// <summary>
+/// Draws trial marker over the image, does nothing for the full version
+/// </summary>
+/// <param name="mat">[in, out] Image to mark</param>
+static void utils_draw_trial_marker(cv::Mat &mat)
+{
 #ifdef OPENCV_SHARP_TRIAL
+	auto size = mat.size();
+	auto text = "Trial OpenCV Plus Unity";
+
+	int baseLine;
+	auto textSize = cv::getTextSize(text, cv::FONT_HERSHEY_SIMPLEX, 1.0, 1, &baseLine);
+	auto textScale = 0.7 * (size.width / textSize.width);
+	auto fontThickness = std::max(1, (int)textScale);
+	textSize = cv::getTextSize(text, cv::FONT_HERSHEY_SIMPLEX, textScale, fontThickness, &baseLine);
+
+	auto padding = int(textSize.width * 0.1);
+	cv::putText(mat, text, cv::Point(padding, size.height - textSize.height - padding), cv::FONT_HERSHEY_SIMPLEX, textScale, cv::Scalar(0, 0, 0), fontThickness + 2);
+	cv::putText(mat, text, cv::Point(1 + padding, 1 + size.height - textSize.height - padding), cv::FONT_HERSHEY_SIMPLEX, textScale, cv::Scalar(255, 255, 255), fontThickness);
+#endif
+}
+
+/// <summary>
+/// Checks whether color conversion into RGBA is a plain channels shuffle that can be fused with other transformations
+/// </summary>
+/// <param name="cn">Source channels count</param>
+/// <param name="colorConversionCode">Color conversion code</param>
+/// <param name="swapRB">[out] True if red and blue channels must be swapped</param>
+/// <returns>True if conversion is supported by the fused kernels</returns>
+static bool utils_rgba_layout(int cn, int colorConversionCode, bool &swapRB)
+{
+	swapRB = false;
+	switch (cn)
 	{
-		auto size = mat->size();
-		auto text = "Trial OpenCV Plus Unity";
+	case 1:
+		return CV_GRAY2RGBA == colorConversionCode;
 
-		int baseLine;
-		auto textSize = cv::getTextSize(text, cv::FONT_HERSHEY_SIMPLEX, 1.0, 1, &baseLine);
-		auto textScale = 0.7 * (size.width / textSize.width);
-		auto fontThickness = std::max(1, (int)textScale);
-		textSize = cv::getTextSize(text, cv::FONT_HERSHEY_SIMPLEX, textScale, fontThickness, &baseLine);
+	case 3:
+		swapRB = (CV_BGR2RGBA == colorConversionCode);
+		return swapRB || CV_RGB2RGBA == colorConversionCode;
 
-		auto padding = int(textSize.width * 0.1);
-		cv::putText(*mat, text, cv::Point(padding, size.height - textSize.height - padding), cv::FONT_HERSHEY_SIMPLEX, textScale, cv::Scalar(0, 0, 0), fontThickness + 2);
-		cv::putText(*mat, text, cv::Point(1 + padding, 1 + size.height - textSize.height - padding), cv::FONT_HERSHEY_SIMPLEX, textScale, cv::Scalar(255, 255, 255), fontThickness);
+	case 4:
+		swapRB = (CV_BGRA2RGBA == colorConversionCode);
+		return swapRB;
+	}
+
+	return false;
+}
+
+/// <summary>
+/// Converts one row of 1-, 3- or 4-channel pixels into RGBA ones
+/// </summary>
+/// <param name="s">[in] Source row</param>
+/// <param name="d">[out] Output row</param>
+/// <param name="cols">Pixels count</param>
+/// <param name="cn">Source channels count</param>
+/// <param name="swapRB">True to swap red and blue channels</param>
+static void utils_to_rgba_row(const uchar *s, uchar *d, int cols, int cn, bool swapRB)
+{
+	int c = 0;
+
+#if CV_SIMD128
+	cv::v_uint8x16 c0, c1, c2, c3 = cv::v_setall_u8(255);
+	switch (cn)
+	{
+	case 1:
+		for (; c <= cols - 16; c += 16, s += 16, d += 64)
+		{
+			c0 = cv::v_load(s);
+			cv::v_store_interleave(d, c0, c0, c0, c3);
+		}
+		break;
+
+	case 3:
+		for (; c <= cols - 16; c += 16, s += 48, d += 64)
+		{
+			cv::v_load_deinterleave(s, c0, c1, c2);
+			if (swapRB)
+				cv::v_store_interleave(d, c2, c1, c0, c3);
+			else
+				cv::v_store_interleave(d, c0, c1, c2, c3);
+		}
+		break;
+
+	case 4:
+		for (; c <= cols - 16; c += 16, s += 64, d += 64)
+		{
+			cv::v_load_deinterleave(s, c0, c1, c2, c3);
+			if (swapRB)
+				cv::v_store_interleave(d, c2, c1, c0, c3);
+			else
+				cv::v_store_interleave(d, c0, c1, c2, c3);
+		}
+		break;
 	}
 #endif
 
-	// #1 flip
-	cv::Mat flipped(mat->size(), mat->type());
-	cv::flip(*mat, flipped, 0);
+	const int r = (cn > 1 && swapRB) ? 2 : 0;
+	const int g = (cn > 1) ? 1 : 0;
+	const int b = (cn > 1 && !swapRB) ? 2 : 0;
+	for (; c < cols; ++c, s += cn, d += 4)
+	{
+		d[0] = s[r];
+		d[1] = s[g];
+		d[2] = s[b];
+		d[3] = (4 == cn) ? s[3] : 255;
+	}
+}
+
+/// <summary>
+/// Converts one row of 1-, 3- or 4-channel pixels into RGBA ones averaging each (factor x factor) source box
+/// </summary>
+/// <param name="s">[in] Top source row of the boxes</param>
+/// <param name="step">Source row step</param>
+/// <param name="d">[out] Output row</param>
+/// <param name="cols">Output pixels count</param>
+/// <param name="cn">Source channels count</param>
+/// <param name="swapRB">True to swap red and blue channels</param>
+/// <param name="factor">Downscale factor, 2 or 4</param>
+static void utils_to_rgba_box_row(const uchar *s, size_t step, uchar *d, int cols, int cn, bool swapRB, int factor)
+{
+	// factor is a power of two, so is the box area
+	const int shift = (2 == factor) ? 2 : 4;
+	const int half = 1 << (shift - 1);
+
+	const int r = (cn > 1 && swapRB) ? 2 : 0;
+	const int g = (cn > 1) ? 1 : 0;
+	const int b = (cn > 1 && !swapRB) ? 2 : 0;
+	for (int c = 0; c < cols; ++c, s += factor * cn, d += 4)
+	{
+		int sum[4] = { 0, 0, 0, 0 };
+		for (int y = 0; y < factor; ++y)
+		{
+			const uchar *p = s + y * step;
+			for (int x = 0; x < factor; ++x, p += cn)
+				for (int k = 0; k < cn; ++k)
+					sum[k] += p[k];
+		}
+
+		d[0] = (uchar)((sum[r] + half) >> shift);
+		d[1] = (uchar)((sum[g] + half) >> shift);
+		d[2] = (uchar)((sum[b] + half) >> shift);
+		d[3] = (4 == cn) ? (uchar)((sum[3] + half) >> shift) : 255;
+	}
+}
+
+/// <summary>
+/// Converts image into Unity-compatible RGBA one flipping it vertically and (optionally) downscaling in a single pass
+/// </summary>
+/// <param name="src">[in] Source image, 8-bit 1, 3 or 4 channels</param>
+/// <param name="dst">[out] Allocated output image, 4-channel with the source size divided by factor</param>
+/// <param name="cn">Source channels count</param>
+/// <param name="swapRB">True to swap red and blue channels</param>
+/// <param name="factor">Downscale factor, must be one of { 1, 2, 4 }</param>
+/// <param name="range">Output rows to process</param>
+static void utils_to_rgba_transformed(const cv::Mat &src, cv::Mat &dst, int cn, bool swapRB, int factor, const cv::Range &range)
+{
+	// vertical flip is made on the downscaled grid, so it's just a matter of picking proper source rows
+	for (int y = range.start; y < range.end; ++y)
+	{
+		const uchar *s = src.ptr((dst.rows - 1 - y) * factor);
+		if (1 == factor)
+			utils_to_rgba_row(s, dst.ptr(y), dst.cols, cn, swapRB);
+		else
+			utils_to_rgba_box_row(s, src.step, dst.ptr(y), dst.cols, cn, swapRB, factor);
+	}
+}
+
+/// <summary>
+/// Converts image into Unity-compatible RGBA buffer flipping it vertically, writes into pre-allocated output
+/// </summary>
+/// <param name="mat">[in] Source image</param>
+/// <param name="colorConversionCode">Color conversion code, must convert image to the 4-channel RGBA</param>
+/// <param name="factor">Downscale factor, must be one of { 1, 2, 4 }</param>
+/// <param name="output">[out] Allocated output image, 4-channel with the source size divided by factor</param>
+/// <returns>False if the conversion code does not fit the image or does not produce 8-bit RGBA, output is not written then</returns>
+static bool utils_mat_to_rgba_flipped(const cv::Mat &mat, int colorConversionCode, int factor, cv::Mat &output)
+{
+	if (mat.empty())
+		return false;
+
+	// plain channels shuffle (BGR, GRAY etc.) is fused with flip and downscale
+	// output row stripes are processed in parallel
+	bool swapRB;
+	if (CV_8U == mat.depth() && utils_rgba_layout(mat.channels(), colorConversionCode, swapRB))
+	{
+		const int cn = mat.channels();
+		utils_parallel_rows(output.rows, [&](const cv::Range &range) {
+			utils_to_rgba_transformed(mat, output, cn, swapRB, factor, range);
+		});
+		return true;
+	}
+
+	// any other conversion is left to OpenCV: row by row, destination row headers reference the output
+	// memory, so cvtColor writes straight into it and vertical flip costs nothing. The first row goes on
+	// this thread: a code that does not fit the image throws here, not on the pool, and a code that does not
+	// produce 8-bit RGBA re-allocates the row header instead of writing into the output
+	if (1 == factor)
+	{
+		cv::Mat firstRow = output.row(0);
+		try
+		{
+			cv::cvtColor(mat.row(mat.rows - 1), firstRow, colorConversionCode);
+		}
+		catch (const cv::Exception &)
+		{
+			return false;
+		}
+		if (firstRow.data != output.ptr(0))
+			return false;
+
+		utils_parallel_rows(output.rows - 1, [&](const cv::Range &range) {
+			for (int y = range.start + 1; y < range.end + 1; ++y)
+			{
+				cv::Mat outputRow = output.row(y);
+				cv::cvtColor(mat.row(mat.rows - 1 - y), outputRow, colorConversionCode);
+			}
+		});
+		return true;
+	}
+
+	// ... or as a whole if we need to downscale it then
+	cv::Mat rgba;
+	try
+	{
+		cv::cvtColor(mat, rgba, colorConversionCode);
+	}
+	catch (const cv::Exception &)
+	{
+		return false;
+	}
+	if (CV_8UC4 != rgba.type())
+		return false;
+
+	utils_parallel_rows(output.rows, [&](const cv::Range &range) {
+		utils_to_rgba_transformed(rgba, output, 4, false, factor, range);
+	});
+	return true;
+}
+
+/// <summary>
+/// Checks the image might be converted to a texture: 8-bit GRAY, BGR/RGB or BGRA/RGBA, anything else would make
+/// cvtColor write into a differently typed buffer (and throw) deep inside the parallel conversion
+/// </summary>
+static bool utils_is_texture_source(const cv::Mat &mat)
+{
+	return !mat.empty() && CV_8U == mat.depth() && (1 == mat.channels() || 3 == mat.channels() || 4 == mat.channels());
+}
+
+/// <summary>
+/// Picks default Unity color conversion code for the image
+/// </summary>
+static int utils_texture_conversion_code(const cv::Mat &mat)
+{
+	return (mat.channels() == 1) ? CV_GRAY2RGBA : CV_BGR2RGBA;
+}
+
+//------------------------------------------------------------------------------------------------------
+// Settings
+//------------------------------------------------------------------------------------------------------
+
+/// <summary>
+/// Sets minimal stripe height (in output rows) for the parallel texture conversion,
+/// threads count is controlled by core_setNumThreads
+/// </summary>
+/// <param name="rows">Minimal stripe height, values less than 1 are treated as 1</param>
+CVAPI(void) utils_setMinStripeHeight(int rows)
+{
+	utils_minStripeHeight.store(std::max(1, rows));
+}
+
+/// <summary>
+/// Gets minimal stripe height (in output rows) for the parallel texture conversion
+/// </summary>
+CVAPI(int) utils_getMinStripeHeight()
+{
+	return utils_minStripeHeight.load();
+}
+
+//------------------------------------------------------------------------------------------------------
+// Texture <-> Mat conversion
+//------------------------------------------------------------------------------------------------------
+
+/// <summary>
+/// Converts raw pixel dtaa into cv::mat
+/// </summary>
+/// <param name="pixels32">[in] Image pixels as RGBA 32-bit</param>
+/// <param name="w">Image width</param>
+/// <param name="h">Image height</param>
+/// <param name="flipVertically">True to flip image vertically (around X axis), false otherwise</param>
+/// <param name="flipHorizontally">True to flip image horizontally (around Y axis), false otherwise</param>
+/// <param name="rotationAngle">Image rotation angle in CCW direction, must be one of { -270, -180, -90, 0, 90, 180, 270 }</param>
+/// <returns>cv::Mat with image in OpenCV format</returns>
+CVAPI(cv::Mat*) utils_texture_to_mat(unsigned char *pixels32, int w, int h, bool flipVertically, bool flipHorizontally, int rotationAngle)
+{
+	// [Referenced] input buffer, 4-channel RGBA
+	cv::Mat input(h, w, CV_8UC4, pixels32);
+
+	// [Allocated, Heap] output buffer, 3-channel BGR, transformed
+	cv::Mat* output = new cv::Mat();
+	utils_rgba_to_bgr(input, flipVertically, flipHorizontally, rotationAngle, *output);
+
+	// we're good
+	return output;
+}
+
+// colorConversionCode expected to convert mat color to RGBA color that is Unity color space
+CVAPI(cv::Mat*) utils_mat_to_texture_1(cv::Mat *mat, int colorConversionCode)
+{
+	// Reverse of utils_texture_to_mat algorithm
+	cv::Mat *output = new cv::Mat(mat->size(), CV_8UC4);
 
-	// #2 convert color
-	cv::cvtColor(flipped, *output, colorConversionCode);
+	// #0 trial marker
+	utils_draw_trial_marker(*mat);
+
+	// #1 flip + convert color
+	utils_mat_to_rgba_flipped(*mat, colorConversionCode, 1, *output);
 	
 	return output;
 }
 
 CVAPI(cv::Mat*) utils_mat_to_texture_2(cv::Mat *mat)
 {
-	int code = CV_BGR2RGBA;
-	if (mat->channels() == 1) {
-		code = CV_GRAY2RGBA;
-	}
-	return utils_mat_to_texture_1(mat, code);
+	return utils_mat_to_texture_1(mat, utils_texture_conversion_code(*mat));
+}
+
+//------------------------------------------------------------------------------------------------------
+// Texture <-> Mat conversion into caller-owned buffers
+//
+// Functions below never allocate as long as the caller keeps passing the same, properly sized,
+// buffers every frame: output Mat is re-created only if its size or type does not match
+//------------------------------------------------------------------------------------------------------
+
+/// <summary>
+/// Converts raw pixel data into existing cv::Mat, reuses Mat memory whenever possible
+/// </summary>
+/// <param name="pixels32">[in] Image pixels as RGBA 32-bit</param>
+/// <param name="w">Image width</param>
+/// <param name="h">Image height</param>
+/// <param name="flipVertically">True to flip image vertically (around X axis), false otherwise</param>
+/// <param name="flipHorizontally">True to flip image horizontally (around Y axis), false otherwise</param>
+/// <param name="rotationAngle">Image rotation angle in CCW direction, must be one of { -270, -180, -90, 0, 90, 180, 270 }</param>
+/// <param name="output">[in, out] Output cv::Mat, receives 3-channel BGR image</param>
+/// <returns>1 if output Mat memory had to be (re-)allocated, 0 otherwise, -1 if arguments are invalid and nothing has been converted</returns>
+CVAPI(int) utils_texture_to_mat_into(unsigned char *pixels32, int w, int h, bool flipVertically, bool flipHorizontally, int rotationAngle, cv::Mat *output)
+{
+	if (nullptr == pixels32 || nullptr == output || w <= 0 || h <= 0)
+		return -1;
+
+	// [Referenced] input buffer, 4-channel RGBA
+	cv::Mat input(h, w, CV_8UC4, pixels32);
+
+	// [Referenced] output buffer, 3-channel BGR, allocated only on the size/type change
+	return utils_rgba_to_bgr(input, flipVertically, flipHorizontally, rotationAngle, *output) ? 1 : 0;
+}
+
+/// <summary>
+/// Converts cv::Mat into existing Unity-formatted (RGBA, vertically flipped) cv::Mat, reuses output memory whenever possible
+/// </summary>
+/// <param name="mat">[in] Source image</param>
+/// <param name="colorConversionCode">Color conversion code, expected to convert mat color to RGBA color that is Unity color space</param>
+/// <param name="output">[in, out] Output cv::Mat, receives 4-channel RGBA image</param>
+/// <returns>1 if output Mat memory had to be (re-)allocated, 0 otherwise, -1 if arguments are invalid (i.e. not an 8-bit
+/// 1, 3 or 4-channel image) and nothing has been converted</returns>
+CVAPI(int) utils_mat_to_texture_into_1(cv::Mat *mat, int colorConversionCode, cv::Mat *output)
+{
+	if (nullptr == mat || nullptr == output || !utils_is_texture_source(*mat))
+		return -1;
+
+	utils_draw_trial_marker(*mat);
+
+	const uchar *data = output->data;
+	output->create(mat->size(), CV_8UC4);
+	if (!utils_mat_to_rgba_flipped(*mat, colorConversionCode, 1, *output))
+		return -1;
+
+	return (data != output->data) ? 1 : 0;
+}
+
+CVAPI(int) utils_mat_to_texture_into_2(cv::Mat *mat, cv::Mat *output)
+{
+	if (nullptr == mat)
+		return -1;
+
+	return utils_mat_to_texture_into_1(mat, utils_texture_conversion_code(*mat), output);
+}
+
+/// <summary>
+/// Converts cv::Mat right into the raw Unity pixel buffer (pinned Color32[] array or texture raw data), optionally downscaling it,
+/// flip, color conversion and downscale are done in a single pass for GRAY, BGR, RGB and BGRA images
+/// </summary>
+/// <param name="mat">[in] Source image</param>
+/// <param name="colorConversionCode">Color conversion code, expected to convert mat color to RGBA color that is Unity color space</param>
+/// <param name="pixels32">[out] Output buffer, RGBA 32-bit, at least w * h * 4 bytes</param>
+/// <param name="w">Output buffer width, must match image width divided by downscale</param>
+/// <param name="h">Output buffer height, must match image height divided by downscale</param>
+/// <param name="downscale">Downscale factor, must be one of { 1, 2, 4 }, downscaled image is box-filtered</param>
+/// <returns>1 if image has been written, 0 if buffer does not match the image, the image is not an 8-bit 1, 3 or 4-channel one
+/// or the conversion code does not produce RGBA from it</returns>
+CVAPI(int) utils_mat_to_pixels32_3(cv::Mat *mat, int colorConversionCode, unsigned char *pixels32, int w, int h, int downscale)
+{
+	if (nullptr == mat || nullptr == pixels32 || !utils_is_texture_source(*mat))
+		return 0;
+	if ((1 != downscale && 2 != downscale && 4 != downscale) || mat->cols / downscale != w || mat->rows / downscale != h)
+		return 0;
+
+	utils_draw_trial_marker(*mat);
+
+	// [Referenced] output buffer, 4-channel RGBA
+	cv::Mat output(h, w, CV_8UC4, pixels32);
+	return utils_mat_to_rgba_flipped(*mat, colorConversionCode, downscale, output) ? 1 : 0;
+}
+
+CVAPI(int) utils_mat_to_pixels32_4(cv::Mat *mat, unsigned char *pixels32, int w, int h, int downscale)
+{
+	if (nullptr == mat)
+		return 0;
+
+	return utils_mat_to_pixels32_3(mat, utils_texture_conversion_code(*mat), pixels32, w, h, downscale);
+}
+
+/// <summary>
+/// Converts cv::Mat right into the raw Unity pixel buffer (pinned Color32[] array or texture raw data)
+/// </summary>
+/// <param name="mat">[in] Source image</param>
+/// <param name="colorConversionCode">Color conversion code, expected to convert mat color to RGBA color that is Unity color space</param>
+/// <param name="pixels32">[out] Output buffer, RGBA 32-bit, at least w * h * 4 bytes</param>
+/// <param name="w">Output buffer width, must match image width</param>
+/// <param name="h">Output buffer height, must match image height</param>
+/// <returns>1 if image has been written, 0 if buffer does not match the image, the image is not an 8-bit 1, 3 or 4-channel one
+/// or the conversion code does not produce RGBA from it</returns>
+CVAPI(int) utils_mat_to_pixels32_1(cv::Mat *mat, int colorConversionCode, unsigned char *pixels32, int w, int h)
+{
+	return utils_mat_to_pixels32_3(mat, colorConversionCode, pixels32, w, h, 1);
+}
+
+CVAPI(int) utils_mat_to_pixels32_2(cv::Mat *mat, unsigned char *pixels32, int w, int h)
+{
+	return utils_mat_to_pixels32_4(mat, pixels32, w, h, 1);
+}
+
+//------------------------------------------------------------------------------------------------------
+// Camera YUV frames ingestion
+//------------------------------------------------------------------------------------------------------
+
+/// <summary>
+/// Makes output cv::Mat a grayscale view over the luma plane of the YUV frame, no pixel data is copied,
+/// so the Mat is valid only as long as the frame buffer is alive (and pinned)
+/// </summary>
+/// <param name="yPlane">[in] Luma plane</param>
+/// <param name="yStride">Luma row step, bytes</param>
+/// <param name="w">Frame width</param>
+/// <param name="h">Frame height</param>
+/// <param name="output">[out] Output cv::Mat, its own data (if any) is released</param>
+/// <returns>0 on success, -1 if arguments are invalid (output is untouched then)</returns>
+CVAPI(int) utils_yuv_gray_view(unsigned char *yPlane, int yStride, int w, int h, cv::Mat *output)
+{
+	if (nullptr == yPlane || nullptr == output || w <= 0 || h <= 0 || yStride < w)
+		return -1;
+
+	*output = cv::Mat(h, w, CV_8UC1, yPlane, (size_t)yStride);
+	return 0;
+}
+
+/// <summary>
+/// Converts YUV 4:2:0 camera frame into existing cv::Mat applying rotation and flips in a single pass,
+/// reuses Mat memory whenever possible. Supports NV12 (U = uv, V = uv + 1, pixel stride 2), NV21 (V = vu, U = vu + 1,
+/// pixel stride 2), I420/YUV420p (separate U, V planes, pixel stride 1) and Android YUV_420_888 as is
+/// </summary>
+/// <param name="yPlane">[in] Luma plane</param>
+/// <param name="yStride">Luma row step, bytes</param>
+/// <param name="uPlane">[in] First U sample</param>
+/// <param name="vPlane">[in] First V sample</param>
+/// <param name="uvStride">Chroma row step, bytes</param>
+/// <param name="uvPixelStride">Distance between two chroma samples in a row, bytes</param>
+/// <param name="w">Frame width</param>
+/// <param name="h">Frame height</param>
+/// <param name="flipVertically">True to flip image vertically (around X axis), false otherwise</param>
+/// <param name="flipHorizontally">True to flip image horizontally (around Y axis), false otherwise</param>
+/// <param name="rotationAngle">Image rotation angle in CCW direction, must be one of { -270, -180, -90, 0, 90, 180, 270 }</param>
+/// <param name="grayscale">True to produce 1-channel grayscale image (chroma planes are not touched and might be null), false for 3-channel BGR</param>
+/// <param name="output">[in, out] Output cv::Mat</param>
+/// <returns>1 if output Mat memory had to be (re-)allocated, 0 otherwise, -1 if arguments are invalid and nothing has been converted</returns>
+CVAPI(int) utils_yuv_to_mat_into(unsigned char *yPlane, int yStride, unsigned char *uPlane, unsigned char *vPlane, int uvStride, int uvPixelStride,
+	int w, int h, bool flipVertically, bool flipHorizontally, int rotationAngle, bool grayscale, cv::Mat *output)
+{
+	if (nullptr == yPlane || nullptr == output || w <= 0 || h <= 0 || yStride < w)
+		return -1;
+
+	// chroma row must hold (w + 1) / 2 samples
+	if (!grayscale && (nullptr == uPlane || nullptr == vPlane || uvPixelStride < 1 || uvStride <= ((w - 1) / 2) * uvPixelStride))
+		return -1;
+
+	UtilsYuvPlanes planes = { yPlane, uPlane, vPlane, yStride, uvStride, uvPixelStride };
+	bool transpose = utils_resolve_rotation(rotationAngle, flipVertically, flipHorizontally);
+
+	const uchar *data = output->data;
+	output->create(transpose ? w : h, transpose ? h : w, grayscale ? CV_8UC1 : CV_8UC3);
+
+	// plain grayscale is just a luma plane copy
+	if (grayscale && !transpose && !flipVertically && !flipHorizontally)
+		cv::Mat(h, w, CV_8UC1, yPlane, (size_t)yStride).copyTo(*output);
+	else
+		utils_parallel_rows(output->rows, [&](const cv::Range &range) {
+			utils_yuv_transformed(planes, *output, transpose, flipVertically, flipHorizontally, range);
+		});
+
+	return (data != output->data) ? 1 : 0;
 }
 
 #endif /* _CPP_UTILS_H_ */
\ No newline at end of file
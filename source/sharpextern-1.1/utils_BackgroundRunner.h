@@ -0,0 +1,425 @@
+#ifndef _CPP_UTILS_BACKGROUNDRUNNER_H_
+#define _CPP_UTILS_BACKGROUNDRUNNER_H_
+
+#include "utils.h"
+#include "my_threading.h"
+
+#include <deque>
+#include <memory>
+
+//------------------------------------------------------------------------------------------------------
+// Background subtraction runner
+//
+// Owns a background subtractor (MOG2 or KNN) per stream and applies them on a shared pool of worker
+// threads. Every stream has its own pair of lock-free triple buffers, so the Unity thread submits frames
+// and polls masks never waiting for the workers; streams with a fresh frame are queued to the pool, a
+// stream is queued at most once, so its subtractor is never applied by two workers at the same time
+//------------------------------------------------------------------------------------------------------
+
+/// <summary>
+/// Submitted frame slot
+/// </summary>
+struct BackgroundRunnerInput
+{
+	cv::Mat pixels;					// RGBA texture pixels or BGR/gray image
+	bool texture;					// true if pixels are Unity texture pixels that must be converted
+	bool flipVertically;
+	bool flipHorizontally;
+	int rotationAngle;
+	int64 frameId;
+	int64 submitTicks;
+};
+
+/// <summary>
+/// Completed result slot, mask buffer is re-used between frames
+/// </summary>
+struct BackgroundRunnerOutput
+{
+	int64 frameId;
+	double processingTime;
+	double waitTime;
+	bool failed;					// the frame could not be processed, mask is empty
+	cv::Mat mask;
+
+	BackgroundRunnerOutput()
+		: frameId(-1), processingTime(0), waitTime(0), failed(false)
+	{}
+};
+
+/// <summary>
+/// Single stream: subtractor, its buffers and pool queue state
+/// </summary>
+struct BackgroundRunnerStream
+{
+	cv::Ptr<cv::BackgroundSubtractor> subtractor;
+	double learningRate;
+
+	int64 submitted;
+	TripleBuffer<BackgroundRunnerInput> input;
+	TripleBuffer<BackgroundRunnerOutput> output;
+	bool queued;					// guarded by the runner mutex
+
+	cv::Mat bgr;					// worker-owned
+
+	BackgroundRunnerStream(const cv::Ptr<cv::BackgroundSubtractor> &subtractor)
+		: subtractor(subtractor), learningRate(-1), submitted(0), queued(false)
+	{}
+};
+
+/// <summary>
+/// Background subtraction runner: owns the streams and the worker pool
+/// </summary>
+class BackgroundRunner
+{
+public:
+	BackgroundRunner()
+		: running(false)
+	{}
+
+	~BackgroundRunner()
+	{
+		stop();
+	}
+
+	/// <summary>
+	/// Adds stream, must be called while the runner is stopped
+	/// </summary>
+	/// <returns>Stream index, -1 if the runner is running</returns>
+	int addStream(const cv::Ptr<cv::BackgroundSubtractor> &subtractor)
+	{
+		if (running)
+			return -1;
+
+		streams.push_back(std::unique_ptr<BackgroundRunnerStream>(new BackgroundRunnerStream(subtractor)));
+		return (int)streams.size() - 1;
+	}
+
+	int streamsCount() const
+	{
+		return (int)streams.size();
+	}
+
+	bool isStream(int stream) const
+	{
+		return stream >= 0 && stream < (int)streams.size();
+	}
+
+	BackgroundRunnerStream& getStream(int stream)
+	{
+		return *streams[stream];
+	}
+
+	/// <summary>
+	/// Starts the worker pool
+	/// </summary>
+	/// <param name="threads">Workers count, 0 for one per stream limited by the number of CPUs</param>
+	void start(int threads)
+	{
+		if (running)
+			return;
+
+		if (threads <= 0)
+			threads = std::min(std::max((int)streams.size(), 1), std::max(cv::getNumberOfCPUs(), 1));
+
+		running = true;
+		for (int i = 0; i < threads; ++i)
+			workers.push_back(std::thread(&BackgroundRunner::run, this));
+	}
+
+	/// <summary>
+	/// Stops the worker pool waiting for the frames in progress, queued streams are processed after the next start
+	/// </summary>
+	void stop()
+	{
+		if (!running)
+			return;
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			running = false;
+		}
+		wakeup.notify_all();
+		for (size_t i = 0; i < workers.size(); ++i)
+			workers[i].join();
+		workers.clear();
+	}
+
+	bool isRunning() const
+	{
+		return running;
+	}
+
+	/// <summary>
+	/// Producer side: slot for the next frame of the stream
+	/// </summary>
+	BackgroundRunnerInput& nextFrame(int stream)
+	{
+		return streams[stream]->input.writeBuffer();
+	}
+
+	/// <summary>
+	/// Producer side: publishes the frame written into nextFrame() and queues the stream unless it's queued already
+	/// </summary>
+	int64 submit(int stream)
+	{
+		BackgroundRunnerStream &s = *streams[stream];
+		BackgroundRunnerInput &frame = s.input.writeBuffer();
+		frame.frameId = s.submitted++;
+		frame.submitTicks = cv::getTickCount();
+		s.input.publish();
+
+		bool queue = false;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (!s.queued)
+			{
+				s.queued = true;
+				pending.push_back(stream);
+				queue = true;
+			}
+		}
+		if (queue)
+			wakeup.notify_one();
+
+		return frame.frameId;
+	}
+
+	/// <summary>
+	/// Consumer side: takes the latest completed result of the stream
+	/// </summary>
+	/// <returns>True if there is a new result since the last poll</returns>
+	bool poll(int stream)
+	{
+		return streams[stream]->output.acquire();
+	}
+
+	/// <summary>
+	/// Consumer side: the latest polled result of the stream
+	/// </summary>
+	BackgroundRunnerOutput& result(int stream)
+	{
+		return streams[stream]->output.readBuffer();
+	}
+
+private:
+	/// <summary>
+	/// Worker thread loop
+	/// </summary>
+	void run()
+	{
+		for (;;)
+		{
+			int stream = -1;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				wakeup.wait(lock, [this] { return !running || !pending.empty(); });
+				if (!running)
+					return;
+
+				stream = pending.front();
+				pending.pop_front();
+			}
+
+			BackgroundRunnerStream &s = *streams[stream];
+			if (s.input.acquire())
+			{
+				process(s, s.input.readBuffer(), s.output.writeBuffer());
+				s.output.publish();
+			}
+
+			// frame submitted while this one was processed: the stream goes back to the queue end
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (s.input.hasFresh())
+					pending.push_back(stream);
+				else
+					s.queued = false;
+			}
+		}
+	}
+
+	/// <summary>
+	/// Applies the stream subtractor to the frame, failure is reported in the result (frame id -1)
+	/// </summary>
+	static void process(BackgroundRunnerStream &s, const BackgroundRunnerInput &frame, BackgroundRunnerOutput &result)
+	{
+		int64 started = cv::getTickCount();
+
+		// nothing may escape the worker thread, std::terminate would take the whole Unity process down
+		try
+		{
+			const cv::Mat *image = &frame.pixels;
+			if (frame.texture)
+			{
+				utils_rgba_to_bgr(frame.pixels, frame.flipVertically, frame.flipHorizontally, frame.rotationAngle, s.bgr);
+				image = &s.bgr;
+			}
+			s.subtractor->apply(*image, result.mask, s.learningRate);
+
+			result.frameId = frame.frameId;
+			result.failed = false;
+		}
+		catch (...)
+		{
+			result.frameId = -1;
+			result.failed = true;
+			result.mask.release();
+		}
+
+		const double ms = 1000.0 / cv::getTickFrequency();
+		result.waitTime = (started - frame.submitTicks) * ms;
+		result.processingTime = (cv::getTickCount() - started) * ms;
+	}
+
+private:
+	std::vector<std::unique_ptr<BackgroundRunnerStream>> streams;
+
+	std::vector<std::thread> workers;
+	std::atomic<bool> running;
+	std::mutex mutex;
+	std::condition_variable wakeup;
+	std::deque<int> pending;
+};
+
+//------------------------------------------------------------------------------------------------------
+// C-wrapper
+//------------------------------------------------------------------------------------------------------
+
+/// <summary>
+/// Allocates new runner with no streams, it's idle until utils_BackgroundRunner_start is called
+/// </summary>
+CVAPI(BackgroundRunner*) utils_BackgroundRunner_new()
+{
+	return new BackgroundRunner();
+}
+
+/// <summary>
+/// Stops the workers and releases the runner
+/// </summary>
+CVAPI(void) utils_BackgroundRunner_delete(BackgroundRunner *obj)
+{
+	delete obj;
+}
+
+/// <summary>
+/// Adds stream with its own MOG2 subtractor, parameters are the same as for video_createBackgroundSubtractorMOG2
+/// </summary>
+/// <returns>Stream index, -1 if the runner is running</returns>
+CVAPI(int) utils_BackgroundRunner_addMOG2(BackgroundRunner *obj, int history, double varThreshold, int detectShadows)
+{
+	if (obj->isRunning())
+		return -1;
+
+	return obj->addStream(cv::createBackgroundSubtractorMOG2(history, varThreshold, detectShadows != 0));
+}
+
+/// <summary>
+/// Adds stream with its own KNN subtractor, parameters are the same as for video_createBackgroundSubtractorKNN
+/// </summary>
+/// <returns>Stream index, -1 if the runner is running</returns>
+CVAPI(int) utils_BackgroundRunner_addKNN(BackgroundRunner *obj, int history, double dist2Threshold, int detectShadows)
+{
+	if (obj->isRunning())
+		return -1;
+
+	return obj->addStream(cv::createBackgroundSubtractorKNN(history, dist2Threshold, detectShadows != 0));
+}
+
+CVAPI(int) utils_BackgroundRunner_streamsCount(BackgroundRunner *obj)
+{
+	return obj->streamsCount();
+}
+
+/// <summary>
+/// Sets stream learning rate, same meaning as for cv::BackgroundSubtractor::apply; must be called while the runner is stopped
+/// </summary>
+CVAPI(void) utils_BackgroundRunner_setLearningRate(BackgroundRunner *obj, int stream, double learningRate)
+{
+	if (obj->isRunning() || !obj->isStream(stream))
+		return;
+
+	obj->getStream(stream).learningRate = learningRate;
+}
+
+/// <summary>
+/// Starts the worker pool
+/// </summary>
+/// <param name="threads">Workers count, 0 for one per stream limited by the number of CPUs</param>
+CVAPI(void) utils_BackgroundRunner_start(BackgroundRunner *obj, int threads)
+{
+	obj->start(threads);
+}
+
+CVAPI(void) utils_BackgroundRunner_stop(BackgroundRunner *obj)
+{
+	obj->stop();
+}
+
+/// <summary>
+/// Submits Unity texture pixels to the stream, copies them and returns immediately, conversion (see utils_texture_to_mat) is done by a worker
+/// </summary>
+/// <param name="pixels32">[in] Image pixels as RGBA 32-bit</param>
+/// <param name="w">Image width</param>
+/// <param name="h">Image height</param>
+/// <param name="flipVertically">True to flip image vertically (around X axis), false otherwise</param>
+/// <param name="flipHorizontally">True to flip image horizontally (around Y axis), false otherwise</param>
+/// <param name="rotationAngle">Image rotation angle in CCW direction, must be one of { -270, -180, -90, 0, 90, 180, 270 }</param>
+/// <returns>Submitted frame id, -1 if there is no such stream or arguments are invalid (nothing is submitted then)</returns>
+CVAPI(int64) utils_BackgroundRunner_submitTexture(BackgroundRunner *obj, int stream, unsigned char *pixels32, int w, int h, bool flipVertically, bool flipHorizontally, int rotationAngle)
+{
+	if (!obj->isStream(stream) || nullptr == pixels32 || w <= 0 || h <= 0)
+		return -1;
+
+	BackgroundRunnerInput &frame = obj->nextFrame(stream);
+	cv::Mat(h, w, CV_8UC4, pixels32).copyTo(frame.pixels);
+	frame.texture = true;
+	frame.flipVertically = flipVertically;
+	frame.flipHorizontally = flipHorizontally;
+	frame.rotationAngle = rotationAngle;
+
+	return obj->submit(stream);
+}
+
+/// <summary>
+/// Submits BGR or grayscale image to the stream, copies it and returns immediately
+/// </summary>
+/// <param name="image">[in] Non-empty 8-bit BGR or grayscale image</param>
+/// <returns>Submitted frame id, -1 if there is no such stream or the image is null, empty or of another type (nothing is submitted then)</returns>
+CVAPI(int64) utils_BackgroundRunner_submitMat(BackgroundRunner *obj, int stream, cv::Mat *image)
+{
+	if (!obj->isStream(stream) || nullptr == image || image->empty() || (image->type() != CV_8UC1 && image->type() != CV_8UC3))
+		return -1;
+
+	BackgroundRunnerInput &frame = obj->nextFrame(stream);
+	image->copyTo(frame.pixels);
+	frame.texture = false;
+
+	return obj->submit(stream);
+}
+
+/// <summary>
+/// Polls the latest completed result of the stream, never waits for the workers
+/// </summary>
+/// <param name="mask">[out] Foreground mask, written only if there is a new result; might be null</param>
+/// <param name="result">[out] Result frame id and timings, describes the previous result if there is no new one; frame id is -1
+/// and error is set if the frame processing has failed</param>
+/// <returns>1 if there is a new result since the last poll, 0 otherwise, -1 if there is no such stream</returns>
+CVAPI(int) utils_BackgroundRunner_poll(BackgroundRunner *obj, int stream, cv::Mat *mask, utils_BackgroundRunnerResult *result)
+{
+	if (!obj->isStream(stream))
+		return -1;
+
+	int fresh = obj->poll(stream) ? 1 : 0;
+
+	BackgroundRunnerOutput &output = obj->result(stream);
+	if (fresh && nullptr != mask)
+		output.mask.copyTo(*mask);
+
+	result->frameId = output.frameId;
+	result->processingTime = output.processingTime;
+	result->waitTime = output.waitTime;
+	result->error = output.failed ? 1 : 0;
+	return fresh;
+}
+
+#endif // _CPP_UTILS_BACKGROUNDRUNNER_H_
@@ -0,0 +1,432 @@
+#ifndef _CPP_UTILS_FRAMEPIPELINE_H_
+#define _CPP_UTILS_FRAMEPIPELINE_H_
+
+#include "utils.h"
+#include "my_threading.h"
+
+// dlib
+#include <dlib/image_processing.h>
+#include <dlib/opencv/cv_image.h>
+
+//------------------------------------------------------------------------------------------------------
+// Asynchronous frame pipeline
+//
+// Unity thread submits frames and polls results, both calls never wait for the detection: frames and
+// results are passed through lock-free triple buffers, so the worker always takes the latest submitted
+// frame (older ones are dropped) and the Unity thread always reads the latest completed result
+//------------------------------------------------------------------------------------------------------
+
+/// <summary>
+/// Submitted frame slot
+/// </summary>
+struct FramePipelineInput
+{
+	cv::Mat pixels;					// RGBA texture pixels or BGR/gray image
+	bool texture;					// true if pixels are Unity texture pixels that must be converted
+	bool flipVertically;
+	bool flipHorizontally;
+	int rotationAngle;
+	int64 frameId;
+};
+
+/// <summary>
+/// Completed result slot, vectors are only cleared between frames, so their memory is re-used
+/// </summary>
+struct FramePipelineOutput
+{
+	int64 frameId;
+	double processingTime;
+	bool failed;					// the frame could not be processed, there are no detections
+	std::vector<cv::Rect> faces;
+	int partsPerFace;
+	std::vector<CvVec2i> landmarks;
+	std::vector<int> markerIds;
+	std::vector<std::vector<cv::Point2f>> markerCorners;
+	std::vector<MyCvPoint2D32f> markerCornersFlat;
+
+	FramePipelineOutput()
+		: frameId(-1), processingTime(0), failed(false), partsPerFace(0)
+	{}
+};
+
+/// <summary>
+/// Frame pipeline: owns the worker thread, detectors and frame/result buffers
+/// </summary>
+class FramePipeline
+{
+public:
+	FramePipeline()
+		: running(false), submitted(0),
+		  scaleFactor(1.2), minNeighbors(6), minSize(0, 0), equalizeHist(true),
+		  shapePredictor(nullptr)
+	{}
+
+	~FramePipeline()
+	{
+		stop();
+	}
+
+	/// <summary>
+	/// Starts the worker, detectors must be configured before that
+	/// </summary>
+	void start()
+	{
+		if (running)
+			return;
+
+		running = true;
+		worker = std::thread(&FramePipeline::run, this);
+	}
+
+	/// <summary>
+	/// Stops the worker waiting for the frame in progress
+	/// </summary>
+	void stop()
+	{
+		if (!running)
+			return;
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			running = false;
+		}
+		wakeup.notify_one();
+		worker.join();
+	}
+
+	bool isRunning() const
+	{
+		return running;
+	}
+
+	/// <summary>
+	/// Producer side: slot for the next frame
+	/// </summary>
+	FramePipelineInput& nextFrame()
+	{
+		return input.writeBuffer();
+	}
+
+	/// <summary>
+	/// Producer side: publishes the frame written into nextFrame() and wakes the worker up
+	/// </summary>
+	int64 submit()
+	{
+		FramePipelineInput &frame = input.writeBuffer();
+		frame.frameId = submitted++;
+		input.publish();
+
+		// empty critical section guarantees the worker is either waiting already or will see the fresh frame
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+		}
+		wakeup.notify_one();
+
+		return frame.frameId;
+	}
+
+	/// <summary>
+	/// Consumer side: takes the latest completed result
+	/// </summary>
+	/// <returns>True if there is a new result since the last poll</returns>
+	bool poll()
+	{
+		return output.acquire();
+	}
+
+	/// <summary>
+	/// Consumer side: the latest polled result
+	/// </summary>
+	FramePipelineOutput& result()
+	{
+		return output.readBuffer();
+	}
+
+public:
+	// face detector
+	cv::CascadeClassifier faceCascade;
+	double scaleFactor;
+	int minNeighbors;
+	cv::Size minSize;
+	bool equalizeHist;
+
+	// landmarks detector, not owned
+	dlib::shape_predictor *shapePredictor;
+
+	// markers detector
+	cv::Ptr<cv::aruco::Dictionary> dictionary;
+	cv::Ptr<cv::aruco::DetectorParameters> detectorParameters;
+
+private:
+	/// <summary>
+	/// Worker thread loop
+	/// </summary>
+	void run()
+	{
+		while (running)
+		{
+			if (!input.acquire())
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				wakeup.wait_for(lock, std::chrono::milliseconds(100), [this] { return !running || input.hasFresh(); });
+				continue;
+			}
+
+			process(input.readBuffer(), output.writeBuffer());
+			output.publish();
+		}
+	}
+
+	/// <summary>
+	/// Runs all configured detectors over the frame, failure is reported in the result (frame id -1, no detections)
+	/// </summary>
+	void process(const FramePipelineInput &frame, FramePipelineOutput &result)
+	{
+		int64 started = cv::getTickCount();
+
+		// nothing may escape the worker thread, std::terminate would take the whole Unity process down
+		try
+		{
+			detect(frame, result);
+			result.frameId = frame.frameId;
+			result.failed = false;
+		}
+		catch (...)
+		{
+			result.frameId = -1;
+			result.failed = true;
+			result.faces.clear();
+			result.landmarks.clear();
+			result.partsPerFace = 0;
+			result.markerIds.clear();
+			result.markerCorners.clear();
+			result.markerCornersFlat.clear();
+		}
+
+		result.processingTime = (cv::getTickCount() - started) * 1000.0 / cv::getTickFrequency();
+	}
+
+	/// <summary>
+	/// Detectors themselves
+	/// </summary>
+	void detect(const FramePipelineInput &frame, FramePipelineOutput &result)
+	{
+		// #0 import
+		const cv::Mat *image = &frame.pixels;
+		if (frame.texture)
+		{
+			utils_rgba_to_bgr(frame.pixels, frame.flipVertically, frame.flipHorizontally, frame.rotationAngle, bgr);
+			image = &bgr;
+		}
+
+		if (image->channels() == 1)
+			image->copyTo(gray);
+		else
+			cv::cvtColor(*image, gray, (image->channels() == 4) ? CV_BGRA2GRAY : CV_BGR2GRAY);
+
+		// #1 markers, on the original grayscale image
+		result.markerIds.clear();
+		result.markerCornersFlat.clear();
+		if (!dictionary.empty())
+		{
+			cv::aruco::detectMarkers(gray, dictionary, result.markerCorners, result.markerIds, detectorParameters.empty() ? cv::aruco::DetectorParameters::create() : detectorParameters);
+			for (size_t i = 0; i < result.markerCorners.size(); ++i)
+				for (size_t j = 0; j < result.markerCorners[i].size(); ++j)
+					result.markerCornersFlat.push_back(c(result.markerCorners[i][j]));
+		}
+
+		// #2 faces, normalized the same way demo FaceProcessor does
+		result.faces.clear();
+		result.landmarks.clear();
+		result.partsPerFace = 0;
+		if (!faceCascade.empty())
+		{
+			if (equalizeHist)
+				cv::equalizeHist(gray, equalized);
+			else
+				equalized = gray;
+			faceCascade.detectMultiScale(equalized, result.faces, scaleFactor, minNeighbors, 0, minSize);
+
+			// #3 landmarks
+			if (nullptr != shapePredictor)
+			{
+				dlib::cv_image<unsigned char> img(equalized);
+				for (size_t i = 0; i < result.faces.size(); ++i)
+				{
+					const cv::Rect &roi = result.faces[i];
+					dlib::full_object_detection fod = (*shapePredictor)(img, dlib::rectangle(roi.x, roi.y, roi.x + roi.width, roi.y + roi.height));
+
+					result.partsPerFace = (int)fod.num_parts();
+					for (unsigned long p = 0; p < fod.num_parts(); ++p)
+					{
+						CvVec2i pt = { { (int)fod.part(p).x(), (int)fod.part(p).y() } };
+						result.landmarks.push_back(pt);
+					}
+				}
+			}
+		}
+	}
+
+private:
+	std::thread worker;
+	std::atomic<bool> running;
+	std::mutex mutex;
+	std::condition_variable wakeup;
+
+	int64 submitted;
+	TripleBuffer<FramePipelineInput> input;
+	TripleBuffer<FramePipelineOutput> output;
+
+	// worker-owned buffers
+	cv::Mat bgr;
+	cv::Mat gray;
+	cv::Mat equalized;
+};
+
+//------------------------------------------------------------------------------------------------------
+// C-wrapper
+//------------------------------------------------------------------------------------------------------
+
+/// <summary>
+/// Allocates new frame pipeline, it's idle until utils_FramePipeline_start is called
+/// </summary>
+CVAPI(FramePipeline*) utils_FramePipeline_new()
+{
+	return new FramePipeline();
+}
+
+/// <summary>
+/// Stops the worker and releases the pipeline
+/// </summary>
+CVAPI(void) utils_FramePipeline_delete(FramePipeline *obj)
+{
+	delete obj;
+}
+
+/// <summary>
+/// Loads face cascade, pipeline keeps its own cv::CascadeClassifier instance
+/// </summary>
+/// <returns>1 on success, 0 if cascade failed to load or the pipeline is running</returns>
+CVAPI(int) utils_FramePipeline_readFaceCascade(FramePipeline *obj, cv::FileNode *node)
+{
+	if (obj->isRunning() || nullptr == node)
+		return 0;
+
+	return obj->faceCascade.read(*node) ? 1 : 0;
+}
+
+/// <summary>
+/// Sets face detection parameters, same meaning as for cv::CascadeClassifier::detectMultiScale
+/// </summary>
+CVAPI(void) utils_FramePipeline_setFaceDetection(FramePipeline *obj, double scaleFactor, int minNeighbors, MyCvSize minSize, int equalizeHist)
+{
+	if (obj->isRunning())
+		return;
+
+	obj->scaleFactor = scaleFactor;
+	obj->minNeighbors = minNeighbors;
+	obj->minSize = cpp(minSize);
+	obj->equalizeHist = equalizeHist != 0;
+}
+
+/// <summary>
+/// Sets landmarks predictor, run for each detected face. Predictor is not owned and must outlive the pipeline (or be reset with null)
+/// </summary>
+CVAPI(void) utils_FramePipeline_setShapePredictor(FramePipeline *obj, dlib::shape_predictor *predictor)
+{
+	if (obj->isRunning())
+		return;
+
+	obj->shapePredictor = predictor;
+}
+
+/// <summary>
+/// Sets markers detector, null dictionary disables markers detection
+/// </summary>
+CVAPI(void) utils_FramePipeline_setMarkerDetection(FramePipeline *obj, cv::Ptr<cv::aruco::Dictionary> *dictionary, cv::Ptr<cv::aruco::DetectorParameters> *parameters)
+{
+	if (obj->isRunning())
+		return;
+
+	obj->dictionary = (nullptr != dictionary) ? *dictionary : cv::Ptr<cv::aruco::Dictionary>();
+	obj->detectorParameters = (nullptr != parameters) ? *parameters : cv::Ptr<cv::aruco::DetectorParameters>();
+}
+
+CVAPI(void) utils_FramePipeline_start(FramePipeline *obj)
+{
+	obj->start();
+}
+
+CVAPI(void) utils_FramePipeline_stop(FramePipeline *obj)
+{
+	obj->stop();
+}
+
+/// <summary>
+/// Submits Unity texture pixels, copies them and returns immediately, conversion (see utils_texture_to_mat) is done by the worker
+/// </summary>
+/// <param name="pixels32">[in] Image pixels as RGBA 32-bit</param>
+/// <param name="w">Image width</param>
+/// <param name="h">Image height</param>
+/// <param name="flipVertically">True to flip image vertically (around X axis), false otherwise</param>
+/// <param name="flipHorizontally">True to flip image horizontally (around Y axis), false otherwise</param>
+/// <param name="rotationAngle">Image rotation angle in CCW direction, must be one of { -270, -180, -90, 0, 90, 180, 270 }</param>
+/// <returns>Submitted frame id, -1 if arguments are invalid (nothing is submitted then)</returns>
+CVAPI(int64) utils_FramePipeline_submitTexture(FramePipeline *obj, unsigned char *pixels32, int w, int h, bool flipVertically, bool flipHorizontally, int rotationAngle)
+{
+	if (nullptr == pixels32 || w <= 0 || h <= 0)
+		return -1;
+
+	FramePipelineInput &frame = obj->nextFrame();
+	cv::Mat(h, w, CV_8UC4, pixels32).copyTo(frame.pixels);
+	frame.texture = true;
+	frame.flipVertically = flipVertically;
+	frame.flipHorizontally = flipHorizontally;
+	frame.rotationAngle = rotationAngle;
+
+	return obj->submit();
+}
+
+/// <summary>
+/// Submits BGR or grayscale image, copies it and returns immediately
+/// </summary>
+/// <param name="image">[in] Non-empty 8-bit BGR, BGRA or grayscale image</param>
+/// <returns>Submitted frame id, -1 if the image is null, empty or of another type (nothing is submitted then)</returns>
+CVAPI(int64) utils_FramePipeline_submitMat(FramePipeline *obj, cv::Mat *image)
+{
+	if (nullptr == image || image->empty() || image->depth() != CV_8U || (image->channels() != 1 && image->channels() != 3 && image->channels() != 4))
+		return -1;
+
+	FramePipelineInput &frame = obj->nextFrame();
+	image->copyTo(frame.pixels);
+	frame.texture = false;
+
+	return obj->submit();
+}
+
+/// <summary>
+/// Polls the latest completed result, never waits for the worker
+/// </summary>
+/// <param name="result">[out] Result, its arrays are owned by the pipeline and stay valid until the next poll; frame id is -1
+/// and error is set if the frame processing has failed</param>
+/// <returns>1 if there is a new result since the last poll, 0 otherwise (result describes the previous one then)</returns>
+CVAPI(int) utils_FramePipeline_poll(FramePipeline *obj, utils_FramePipelineResult *result)
+{
+	int fresh = obj->poll() ? 1 : 0;
+
+	FramePipelineOutput &output = obj->result();
+	result->frameId = output.frameId;
+	result->processingTime = output.processingTime;
+	result->error = output.failed ? 1 : 0;
+	result->facesCount = (int)output.faces.size();
+	result->faces = output.faces.empty() ? nullptr : reinterpret_cast<MyCvRect*>(output.faces.data());
+	result->partsPerFace = output.partsPerFace;
+	result->landmarks = output.landmarks.empty() ? nullptr : output.landmarks.data();
+	result->markersCount = (int)output.markerIds.size();
+	result->markerIds = output.markerIds.empty() ? nullptr : output.markerIds.data();
+	result->markerCorners = output.markerCornersFlat.empty() ? nullptr : output.markerCornersFlat.data();
+
+	return fresh;
+}
+
+#endif // _CPP_UTILS_FRAMEPIPELINE_H_
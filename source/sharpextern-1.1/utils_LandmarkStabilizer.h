@@ -0,0 +1,318 @@
+#ifndef _CPP_UTILS_LANDMARKSTABILIZER_H_
+#define _CPP_UTILS_LANDMARKSTABILIZER_H_
+
+#include "include_opencv.h"
+#include <opencv2/core/hal/intrin.hpp>
+
+#include <map>
+
+//------------------------------------------------------------------------------------------------------
+// Landmark stabilizer
+//
+// Native counterpart of the demo PointsDataStabilizer, consumes the flat (x, y) landmarks buffer written
+// by dlib_shapePredictor_detectLandmarksBatch and stabilizes all points of all faces within a single call.
+// State is kept per face id, faces missing for more than maxMissedFrames calls are forgotten; within a face
+// one-euro filtering and samples averaging run 4 values at a time with OpenCV universal intrinsics.
+//
+// Modes:
+//  - one-euro: adaptive low-pass per coordinate, cutoff grows with the speed, so slow jitter is damped
+//    and fast motion passes with little lag
+//  - threshold: PointsDataStabilizer logic, the last samplesCount frames are averaged and the average
+//    replaces the output once the mean (or per-point) distance to it exceeds the threshold
+//------------------------------------------------------------------------------------------------------
+
+#pragma region LandmarkStabilizer
+
+enum LandmarkStabilizerMode
+{
+	LandmarkStabilizer_OneEuro = 0,
+	LandmarkStabilizer_Threshold = 1
+};
+
+class LandmarkStabilizer
+{
+public:
+	LandmarkStabilizer()
+		: mode(LandmarkStabilizer_OneEuro), minCutoff(1.f), beta(0.05f), derivativeCutoff(1.f),
+		  threshold(1.f), samplesCount(10), perPoint(true), maxMissedFrames(5)
+	{}
+
+	/// <summary>
+	/// Stabilizes faces landmarks
+	/// </summary>
+	/// <param name="points">(x, y) pairs, pointsPerFace points face after face</param>
+	/// <param name="faceIds">Faces ids, state is kept per id; null to use faces indices</param>
+	/// <param name="dt">Time passed since the previous call, seconds</param>
+	/// <param name="output">Stabilized (x, y) pairs, same layout</param>
+	void process(const int *points, int facesCount, const int *faceIds, int pointsPerFace, float dt, float *output)
+	{
+		for (auto it = faces.begin(); it != faces.end(); ++it)
+			it->second.seen = false;
+
+		const int values = pointsPerFace * 2;
+		for (int f = 0; f < facesCount; ++f)
+		{
+			const int id = (nullptr != faceIds) ? faceIds[f] : f;
+			const int *in = points + f * values;
+			float *out = output + f * values;
+
+			// new face or the layout changed: start from the raw points
+			Face &face = faces[id];
+			face.seen = true;
+			face.missed = 0;
+			if ((int)face.x.size() != values)
+			{
+				face.reset(in, values);
+				std::copy(face.x.begin(), face.x.end(), out);
+				continue;
+			}
+
+			if (LandmarkStabilizer_Threshold == mode)
+				processThreshold(face, in, values, out);
+			else
+				processOneEuro(face, in, values, std::max(dt, 1e-4f), out);
+		}
+
+		for (auto it = faces.begin(); it != faces.end();)
+		{
+			if (!it->second.seen && ++it->second.missed > maxMissedFrames)
+				it = faces.erase(it);
+			else
+				++it;
+		}
+	}
+
+	void reset()
+	{
+		faces.clear();
+	}
+
+private:
+	struct Face
+	{
+		std::vector<float> x;				// filtered values (one-euro), current output (threshold)
+		std::vector<float> dx;				// filtered derivative (one-euro)
+		std::vector<float> samples;			// last samplesCount frames, ring buffer (threshold)
+		int head;
+		int stored;
+		bool averaged;
+		int missed;
+		bool seen;
+
+		void reset(const int *in, int values)
+		{
+			x.assign(in, in + values);
+			dx.assign(values, 0.f);
+			samples.clear();
+			head = 0;
+			stored = 0;
+			averaged = false;
+		}
+	};
+
+	void processOneEuro(Face &face, const int *in, int values, float dt, float *out) const
+	{
+		// alpha = 1 / (1 + tau / dt), tau = 1 / (2 pi cutoff)
+		const float rate = 1.f / dt;
+		const float tauRate = rate / (2.f * (float)CV_PI);
+		const float alphaD = 1.f / (1.f + tauRate / derivativeCutoff);
+
+		float *x = face.x.data(), *dx = face.dx.data();
+		int i = 0;
+#if CV_SIMD128
+		const cv::v_float32x4 vrate = cv::v_setall_f32(rate), vtauRate = cv::v_setall_f32(tauRate), valphaD = cv::v_setall_f32(alphaD);
+		const cv::v_float32x4 vminCutoff = cv::v_setall_f32(minCutoff), vbeta = cv::v_setall_f32(beta);
+		const cv::v_float32x4 zero = cv::v_setzero_f32(), one = cv::v_setall_f32(1.f);
+		for (; i <= values - 4; i += 4)
+		{
+			cv::v_float32x4 value = cv::v_cvt_f32(cv::v_load(in + i)), xi = cv::v_load(x + i), dxi = cv::v_load(dx + i);
+			cv::v_float32x4 d = dxi + valphaD * ((value - xi) * vrate - dxi);
+			cv::v_float32x4 cutoff = vminCutoff + vbeta * cv::v_max(d, zero - d);
+			cv::v_float32x4 alpha = one / (one + vtauRate / cutoff);
+
+			xi = xi + alpha * (value - xi);
+			cv::v_store(dx + i, d);
+			cv::v_store(x + i, xi);
+			cv::v_store(out + i, xi);
+		}
+#endif
+		for (; i < values; ++i)
+		{
+			float value = (float)in[i];
+			float d = dx[i] + alphaD * ((value - x[i]) * rate - dx[i]);
+			float cutoff = minCutoff + beta * std::abs(d);
+			float alpha = 1.f / (1.f + tauRate / cutoff);
+
+			dx[i] = d;
+			x[i] += alpha * (value - x[i]);
+			out[i] = x[i];
+		}
+	}
+
+	void processThreshold(Face &face, const int *in, int values, float *out)
+	{
+		if ((int)face.samples.size() != samplesCount * values)
+		{
+			face.samples.assign(samplesCount * values, 0.f);
+			face.head = 0;
+			face.stored = 0;
+			face.averaged = false;
+		}
+
+		std::copy(in, in + values, face.samples.begin() + face.head * values);
+		face.head = (face.head + 1) % samplesCount;
+		face.stored = std::min(face.stored + 1, samplesCount);
+
+		// full stack is required, raw points until then
+		if (face.stored < samplesCount)
+		{
+			std::copy(in, in + values, face.x.begin());
+			std::copy(face.x.begin(), face.x.end(), out);
+			return;
+		}
+
+		// average, written into the output
+		const float inv = 1.f / samplesCount;
+		const float *samples = face.samples.data();
+		int i = 0;
+#if CV_SIMD128
+		const cv::v_float32x4 vinv = cv::v_setall_f32(inv);
+		for (; i <= values - 4; i += 4)
+		{
+			cv::v_float32x4 sum = cv::v_setzero_f32();
+			for (int s = 0; s < samplesCount; ++s)
+				sum += cv::v_load(samples + s * values + i);
+			cv::v_store(out + i, sum * vinv);
+		}
+#endif
+		for (; i < values; ++i)
+		{
+			float sum = 0.f;
+			for (int s = 0; s < samplesCount; ++s)
+				sum += samples[s * values + i];
+			out[i] = sum * inv;
+		}
+
+		// distances between the current output and the average
+		const int count = values / 2;
+		float mean = 0.f;
+		distances.resize(count);
+		for (int p = 0; p < count; ++p)
+		{
+			float ddx = out[2 * p] - face.x[2 * p], ddy = out[2 * p + 1] - face.x[2 * p + 1];
+			distances[p] = std::sqrt(ddx * ddx + ddy * ddy);
+			mean += distances[p];
+		}
+		mean /= std::max(count, 1);
+
+		if (!face.averaged || mean > threshold)
+		{
+			face.averaged = true;
+			std::copy(out, out + values, face.x.begin());
+		}
+		else
+		{
+			for (int p = 0; p < count; ++p)
+			{
+				if (perPoint && distances[p] > threshold)
+				{
+					face.x[2 * p] = out[2 * p];
+					face.x[2 * p + 1] = out[2 * p + 1];
+				}
+			}
+		}
+		std::copy(face.x.begin(), face.x.end(), out);
+	}
+
+public:
+	int mode;
+
+	// one-euro
+	float minCutoff;
+	float beta;
+	float derivativeCutoff;
+
+	// threshold
+	float threshold;
+	int samplesCount;
+	bool perPoint;
+
+	int maxMissedFrames;
+
+private:
+	std::map<int, Face> faces;
+	std::vector<float> distances;
+};
+
+//------------------------------------------------------------------------------------------------------
+// C-wrapper
+//------------------------------------------------------------------------------------------------------
+
+CVAPI(LandmarkStabilizer*) utils_LandmarkStabilizer_new()
+{
+	return new LandmarkStabilizer();
+}
+
+CVAPI(void) utils_LandmarkStabilizer_delete(LandmarkStabilizer *obj)
+{
+	delete obj;
+}
+
+/// <summary>
+/// One-euro mode parameters, enables the mode
+/// </summary>
+/// <param name="minCutoff">Cutoff frequency at rest, Hz: lower is smoother</param>
+/// <param name="beta">Cutoff growth with the speed (pixels per second): higher is less lag</param>
+/// <param name="derivativeCutoff">Cutoff frequency of the speed estimation, Hz</param>
+CVAPI(void) utils_LandmarkStabilizer_setOneEuro(LandmarkStabilizer *obj, float minCutoff, float beta, float derivativeCutoff)
+{
+	obj->mode = LandmarkStabilizer_OneEuro;
+	obj->minCutoff = std::max(1e-3f, minCutoff);
+	obj->beta = std::max(0.f, beta);
+	obj->derivativeCutoff = std::max(1e-3f, derivativeCutoff);
+}
+
+/// <summary>
+/// Threshold mode parameters, enables the mode
+/// </summary>
+/// <param name="threshold">Distance, pixels, the average must move away for the output to follow</param>
+/// <param name="samplesCount">Frames averaged</param>
+/// <param name="perPoint">Whether points are updated one by one when the mean distance is below the threshold</param>
+CVAPI(void) utils_LandmarkStabilizer_setThreshold(LandmarkStabilizer *obj, float threshold, int samplesCount, int perPoint)
+{
+	obj->mode = LandmarkStabilizer_Threshold;
+	obj->threshold = std::max(0.f, threshold);
+	obj->samplesCount = std::max(1, samplesCount);
+	obj->perPoint = perPoint != 0;
+}
+
+CVAPI(void) utils_LandmarkStabilizer_setMaxMissedFrames(LandmarkStabilizer *obj, int value)
+{
+	obj->maxMissedFrames = std::max(0, value);
+}
+
+/// <summary>
+/// Stabilizes landmarks of all faces
+/// </summary>
+/// <param name="points">[in] (x, y) pairs, pointsPerFace points face after face, as written by dlib_shapePredictor_detectLandmarksBatch</param>
+/// <param name="faceIds">[in] facesCount ids to keep state by, null to use faces indices</param>
+/// <param name="dt">Seconds passed since the previous call</param>
+/// <param name="output">[out] Stabilized (x, y) pairs, facesCount * pointsPerFace * 2 values</param>
+/// <returns>0 on success, -1 if counts are negative or points/output are null while there are faces (nothing is processed then)</returns>
+CVAPI(int) utils_LandmarkStabilizer_process(LandmarkStabilizer *obj, const int *points, int facesCount, const int *faceIds, int pointsPerFace, float dt, float *output)
+{
+	if (nullptr == obj || facesCount < 0 || pointsPerFace < 0 || (facesCount > 0 && (nullptr == points || nullptr == output)))
+		return -1;
+
+	obj->process(points, facesCount, faceIds, pointsPerFace, dt, output);
+	return 0;
+}
+
+CVAPI(void) utils_LandmarkStabilizer_reset(LandmarkStabilizer *obj)
+{
+	obj->reset();
+}
+
+#pragma endregion
+
+#endif
@@ -1,3 +1,7 @@
 #include "video.h"
 #include "video_tracking.h"
-#include "video_background_segm.h"
\ No newline at end of file
+#include "video_background_segm.h"
+#include "video_KalmanBank.h"
+#include "video_SparseFlowTracker.h"
+#include "video_FeatureTracker.h"
+#include "video_DownscaledFlow.h"
\ No newline at end of file
@@ -0,0 +1,282 @@
+#ifndef _CPP_VIDEO_DOWNSCALEDFLOW_H_
+#define _CPP_VIDEO_DOWNSCALEDFLOW_H_
+
+#include "include_opencv.h"
+
+//------------------------------------------------------------------------------------------------------
+// Downscaled dense flow
+//
+// Dense optical flow front end for continuous video: frames are reduced to the given pyramid level (each
+// level halves the size, so flow costs about 4^level times less), flow is computed there (Farneback or
+// any cv::DenseOpticalFlow, i.e. DualTVL1) and the field is brought back to the full resolution by
+// bilinear upsampling fused with the vectors rescaling, row stripes run in parallel.
+// The previous frame is kept already reduced, so every frame is converted and reduced once
+//------------------------------------------------------------------------------------------------------
+
+#pragma region DownscaledFlow
+
+class DownscaledFlow
+{
+public:
+	DownscaledFlow()
+		: level(2), algorithm(nullptr), pyrScale(0.5), levels(3), winSize(15), iterations(3), polyN(5), polySigma(1.2), flags(0),
+		  hasPrevious(false), columnsSource(0)
+	{
+		timings.downscale = timings.flow = timings.upsample = timings.total = 0;
+	}
+
+	/// <summary>
+	/// Computes full resolution flow between the previous frame and the given one
+	/// </summary>
+	/// <param name="image">8-bit grayscale, BGR or BGRA frame</param>
+	/// <param name="flow">Full resolution CV_32FC2 flow</param>
+	/// <returns>False if there was no previous frame (or its size differs), flow is untouched then</returns>
+	bool process(const cv::Mat &image, cv::Mat &flow)
+	{
+		const double ms = 1000.0 / cv::getTickFrequency();
+		int64 started = cv::getTickCount();
+
+		// #0 grayscale and reduce, the last level goes straight into the kept frame
+		const cv::Mat *source = &image;
+		if (image.channels() > 1)
+		{
+			cv::cvtColor(image, gray, (image.channels() == 4) ? CV_BGRA2GRAY : CV_BGR2GRAY);
+			source = &gray;
+		}
+		if (0 == level)
+			source->copyTo(next);
+		for (int i = 0; i < level; ++i)
+		{
+			cv::Mat &dst = (i == level - 1) ? next : scratch[i % 2];
+			cv::pyrDown(*source, dst);
+			source = &dst;
+		}
+
+		if (next.size() != prev.size())
+			hasPrevious = false;
+
+		int64 reduced = cv::getTickCount();
+		timings.downscale = (reduced - started) * ms;
+		if (!hasPrevious)
+		{
+			std::swap(prev, next);
+			hasPrevious = true;
+			timings.flow = timings.upsample = 0;
+			timings.total = timings.downscale;
+			return false;
+		}
+
+		// #1 flow, previous field is the initial one when asked so
+		if (nullptr != algorithm)
+		{
+			algorithm->calc(prev, next, small);
+		}
+		else
+		{
+			int f = (small.size() == next.size()) ? flags : (flags & ~cv::OPTFLOW_USE_INITIAL_FLOW);
+			cv::calcOpticalFlowFarneback(prev, next, small, pyrScale, levels, winSize, iterations, polyN, polySigma, f);
+		}
+
+		int64 computed = cv::getTickCount();
+		timings.flow = (computed - reduced) * ms;
+
+		// #2 upsample
+		flow.create(image.size(), CV_32FC2);
+		prepareColumns(small.cols, flow.cols);
+		cv::parallel_for_(cv::Range(0, flow.rows), UpsampleInvoker(small, flow, columns, weights));
+
+		std::swap(prev, next);
+
+		int64 finished = cv::getTickCount();
+		timings.upsample = (finished - computed) * ms;
+		timings.total = (finished - started) * ms;
+		return true;
+	}
+
+	/// <summary>
+	/// Drops the previous frame
+	/// </summary>
+	void reset()
+	{
+		hasPrevious = false;
+	}
+
+private:
+	/// <summary>
+	/// Source columns pair and weight per destination column, recomputed on sizes change only
+	/// </summary>
+	void prepareColumns(int sourceWidth, int width)
+	{
+		if ((int)weights.size() == width && sourceWidth == columnsSource)
+			return;
+
+		columnsSource = sourceWidth;
+		columns.resize(width * 2);
+		weights.resize(width);
+
+		const float scale = (float)sourceWidth / width;
+		for (int x = 0; x < width; ++x)
+		{
+			float fx = std::min(std::max((x + 0.5f) * scale - 0.5f, 0.f), (float)(sourceWidth - 1));
+			int x0 = (int)fx;
+			columns[x * 2] = x0;
+			columns[x * 2 + 1] = std::min(x0 + 1, sourceWidth - 1);
+			weights[x] = fx - x0;
+		}
+	}
+
+	/// <summary>
+	/// Bilinear upsampling of the flow field fused with vectors rescaling, rows are independent stripes
+	/// </summary>
+	class UpsampleInvoker : public cv::ParallelLoopBody
+	{
+	public:
+		UpsampleInvoker(const cv::Mat &source, cv::Mat &flow, const std::vector<int> &columns, const std::vector<float> &weights)
+			: source(source), flow(flow), columns(columns), weights(weights),
+			  scaleX((float)flow.cols / source.cols), scaleY((float)flow.rows / source.rows)
+		{}
+
+		virtual void operator() (const cv::Range &range) const
+		{
+			const float rowScale = 1.f / scaleY;
+			const int *cols = columns.data();
+			const float *wx = weights.data();
+
+			for (int y = range.start; y < range.end; ++y)
+			{
+				float fy = std::min(std::max((y + 0.5f) * rowScale - 0.5f, 0.f), (float)(source.rows - 1));
+				int y0 = (int)fy;
+				float wy = fy - y0;
+				const cv::Vec2f *r0 = source.ptr<cv::Vec2f>(y0);
+				const cv::Vec2f *r1 = source.ptr<cv::Vec2f>(std::min(y0 + 1, source.rows - 1));
+				cv::Vec2f *out = flow.ptr<cv::Vec2f>(y);
+
+				for (int x = 0; x < flow.cols; ++x)
+				{
+					const int x0 = cols[x * 2], x1 = cols[x * 2 + 1];
+					const float w = wx[x];
+					float u0 = r0[x0][0] + w * (r0[x1][0] - r0[x0][0]), v0 = r0[x0][1] + w * (r0[x1][1] - r0[x0][1]);
+					float u1 = r1[x0][0] + w * (r1[x1][0] - r1[x0][0]), v1 = r1[x0][1] + w * (r1[x1][1] - r1[x0][1]);
+					out[x][0] = (u0 + wy * (u1 - u0)) * scaleX;
+					out[x][1] = (v0 + wy * (v1 - v0)) * scaleY;
+				}
+			}
+		}
+
+	private:
+		const cv::Mat &source;
+		cv::Mat &flow;
+		const std::vector<int> &columns;
+		const std::vector<float> &weights;
+		const float scaleX;
+		const float scaleY;
+	};
+
+public:
+	int level;
+
+	// custom algorithm, not owned; Farneback with the parameters below if null
+	cv::DenseOpticalFlow *algorithm;
+
+	// Farneback
+	double pyrScale;
+	int levels;
+	int winSize;
+	int iterations;
+	int polyN;
+	double polySigma;
+	int flags;
+
+	// the latest process call, milliseconds
+	video_DenseFlowTimings timings;
+
+private:
+	bool hasPrevious;
+	cv::Mat gray;
+	cv::Mat scratch[2];
+	cv::Mat prev;
+	cv::Mat next;
+	cv::Mat small;
+
+	int columnsSource;
+	std::vector<int> columns;
+	std::vector<float> weights;
+};
+
+//------------------------------------------------------------------------------------------------------
+// C-wrapper
+//------------------------------------------------------------------------------------------------------
+
+/// <summary>
+/// Allocates new flow front end: Farneback at pyramid level 2
+/// </summary>
+CVAPI(DownscaledFlow*) video_DownscaledFlow_new()
+{
+	return new DownscaledFlow();
+}
+
+CVAPI(void) video_DownscaledFlow_delete(DownscaledFlow *obj)
+{
+	delete obj;
+}
+
+/// <summary>
+/// Pyramid level flow is computed at, 0 is the full resolution; drops the previous frame
+/// </summary>
+CVAPI(void) video_DownscaledFlow_setLevel(DownscaledFlow *obj, int level)
+{
+	obj->level = std::min(std::max(level, 0), 6);
+	obj->reset();
+}
+
+CVAPI(int) video_DownscaledFlow_getLevel(DownscaledFlow *obj)
+{
+	return obj->level;
+}
+
+/// <summary>
+/// Switches to Farneback, parameters are the same as for cv::calcOpticalFlowFarneback
+/// </summary>
+CVAPI(void) video_DownscaledFlow_setFarneback(DownscaledFlow *obj, double pyrScale, int levels, int winSize, int iterations, int polyN, double polySigma, int flags)
+{
+	obj->algorithm = nullptr;
+	obj->pyrScale = pyrScale;
+	obj->levels = levels;
+	obj->winSize = winSize;
+	obj->iterations = iterations;
+	obj->polyN = polyN;
+	obj->polySigma = polySigma;
+	obj->flags = flags;
+}
+
+/// <summary>
+/// Switches to custom algorithm (i.e. video_createOptFlow_DualTVL1 one). Algorithm is not owned and must outlive the object (or be reset with null)
+/// </summary>
+CVAPI(void) video_DownscaledFlow_setAlgorithm(DownscaledFlow *obj, cv::DenseOpticalFlow *algorithm)
+{
+	obj->algorithm = algorithm;
+}
+
+/// <summary>
+/// Computes full resolution flow between the previous frame and the given one
+/// </summary>
+/// <param name="image">[in] 8-bit grayscale, BGR or BGRA frame</param>
+/// <param name="flow">[out] Full resolution CV_32FC2 flow</param>
+/// <param name="timings">[out] Stages time, milliseconds, might be null</param>
+/// <returns>1 if flow is computed, 0 if there was no previous frame (the given one just gets stored)</returns>
+CVAPI(int) video_DownscaledFlow_process(DownscaledFlow *obj, cv::Mat *image, cv::Mat *flow, video_DenseFlowTimings *timings)
+{
+	int ret = obj->process(*image, *flow) ? 1 : 0;
+	if (nullptr != timings)
+		*timings = obj->timings;
+	return ret;
+}
+
+CVAPI(void) video_DownscaledFlow_reset(DownscaledFlow *obj)
+{
+	obj->reset();
+}
+
+#pragma endregion
+
+#endif
@@ -0,0 +1,362 @@
+#ifndef _CPP_VIDEO_FEATURETRACKER_H_
+#define _CPP_VIDEO_FEATURETRACKER_H_
+
+#include "include_opencv.h"
+#include "video_SparseFlowTracker.h"
+
+//------------------------------------------------------------------------------------------------------
+// Feature tracker
+//
+// KLT engine: corners are detected (GFTT or FAST) inside the cells of a regular grid, tracked with pyramidal
+// LK (SparseFlowTracker, so every frame pyramid is built once) and validated by the forward-backward check:
+// a point tracked back to the previous frame must land within fbThreshold pixels of where it started.
+// Empty cells are re-seeded only when the share of occupied cells drops below minCoverage.
+//
+// All buffers are reserved for gridCols * gridRows * maxPerCell features, so frames don't allocate
+//------------------------------------------------------------------------------------------------------
+
+#pragma region FeatureTracker
+
+enum FeatureTrackerDetector
+{
+	FeatureTracker_GFTT = 0,
+	FeatureTracker_FAST = 1
+};
+
+enum FeatureStatus
+{
+	Feature_Lost = 0,
+	Feature_Tracked = 1,
+	Feature_Seeded = 2
+};
+
+class FeatureTracker
+{
+public:
+	FeatureTracker(const cv::Size &winSize, int maxLevel)
+		: flow(winSize, maxLevel, cv::TermCriteria(cv::TermCriteria::COUNT | cv::TermCriteria::EPS, 30, 0.01), 0, 1e-4),
+		  nextId(0), detector(FeatureTracker_GFTT), qualityLevel(0.01), minDistance(8.0), fastThreshold(20),
+		  fbThreshold(1.f), minCoverage(0.7f)
+	{
+		setGrid(8, 6, 4);
+	}
+
+	/// <summary>
+	/// Grid layout, drops all the features
+	/// </summary>
+	void setGrid(int cols, int rows, int perCell)
+	{
+		gridCols = cols;
+		gridRows = rows;
+		maxPerCell = perCell;
+		reset();
+
+		const int cells = gridCols * gridRows;
+		const size_t capacity = (size_t)(cells * maxPerCell);
+		features.reserve(capacity);
+		from.reserve(capacity);
+		to.reserve(capacity);
+		back.reserve(capacity);
+		status.reserve(capacity);
+		backStatus.reserve(capacity);
+		cellCounts.resize(cells);
+		seeds.resize(cells);
+		for (size_t i = 0; i < seeds.size(); ++i)
+			seeds[i].reserve(maxPerCell);
+	}
+
+	/// <summary>
+	/// Maximum number of features reported per frame
+	/// </summary>
+	int capacity() const
+	{
+		return gridCols * gridRows * maxPerCell;
+	}
+
+	/// <summary>
+	/// Tracks features to the new frame and re-seeds the grid if required
+	/// </summary>
+	/// <param name="image">8-bit grayscale, BGR or BGRA frame</param>
+	/// <returns>Features, including the ones lost on this frame</returns>
+	const std::vector<video_TrackedFeature>& process(const cv::Mat &image)
+	{
+		// features lost on the previous frame have been reported already
+		features.erase(std::remove_if(features.begin(), features.end(), isLost), features.end());
+
+		if (flow.push(image))
+			track();
+		else
+			features.clear();
+
+		const cv::Mat &gray = flow.frame();
+		const int cells = gridCols * gridRows;
+		const cv::Size cellSize(gray.cols / gridCols, gray.rows / gridRows);
+
+		std::fill(cellCounts.begin(), cellCounts.end(), 0);
+		for (size_t i = 0; i < features.size(); ++i)
+		{
+			if (Feature_Lost != features[i].status)
+				++cellCounts[cellOf(features[i].pt, cellSize)];
+		}
+
+		int occupied = 0;
+		for (int c = 0; c < cells; ++c)
+			occupied += (cellCounts[c] > 0) ? 1 : 0;
+
+		if (occupied < minCoverage * cells && cellSize.area() > 0)
+			seed(gray, cellSize);
+
+		flow.commit();
+		return features;
+	}
+
+	/// <summary>
+	/// Drops the previous frame and all the features
+	/// </summary>
+	void reset()
+	{
+		flow.reset();
+		features.clear();
+	}
+
+private:
+	static bool isLost(const video_TrackedFeature &feature)
+	{
+		return Feature_Lost == feature.status;
+	}
+
+	int cellOf(const MyCvPoint2D32f &pt, const cv::Size &cellSize) const
+	{
+		int x = std::min(std::max((int)pt.x / std::max(cellSize.width, 1), 0), gridCols - 1);
+		int y = std::min(std::max((int)pt.y / std::max(cellSize.height, 1), 0), gridRows - 1);
+		return y * gridCols + x;
+	}
+
+	void track()
+	{
+		const int count = (int)features.size();
+		if (0 == count)
+			return;
+
+		from.resize(count);
+		to.resize(count);
+		back.resize(count);
+		status.resize(count);
+		backStatus.resize(count);
+		for (int i = 0; i < count; ++i)
+			from[i] = cpp(features[i].pt);
+
+		// headers over the reserved buffers, LK writes into them as sizes and types match
+		cv::Mat fromMat(count, 1, CV_32FC2, from.data()), toMat(count, 1, CV_32FC2, to.data()), backMat(count, 1, CV_32FC2, back.data());
+		cv::Mat statusMat(count, 1, CV_8UC1, status.data()), backStatusMat(count, 1, CV_8UC1, backStatus.data());
+		flow.flow(false, fromMat, toMat, statusMat, cv::noArray());
+		flow.flow(true, toMat, backMat, backStatusMat, cv::noArray());
+
+		const cv::Rect2f bounds(0.f, 0.f, (float)flow.frame().cols, (float)flow.frame().rows);
+		const float fb2 = fbThreshold * fbThreshold;
+		for (int i = 0; i < count; ++i)
+		{
+			video_TrackedFeature &feature = features[i];
+			cv::Point2f d = back[i] - from[i];
+			bool ok = status[i] && backStatus[i] && d.dot(d) <= fb2 && bounds.contains(to[i]);
+			if (ok)
+			{
+				feature.pt = c(to[i]);
+				feature.status = Feature_Tracked;
+				++feature.age;
+			}
+			else
+			{
+				feature.status = Feature_Lost;
+			}
+		}
+	}
+
+	void seed(const cv::Mat &gray, const cv::Size &cellSize)
+	{
+		cv::parallel_for_(cv::Range(0, gridCols * gridRows), DetectInvoker(*this, gray, cellSize));
+
+		// tracked features may crowd into the same cells, the total is capped anyway
+		const size_t limit = (size_t)capacity();
+		for (size_t cell = 0; cell < seeds.size(); ++cell)
+		{
+			const std::vector<cv::Point2f> &corners = seeds[cell];
+			for (size_t i = 0; i < corners.size() && features.size() < limit; ++i)
+			{
+				video_TrackedFeature feature;
+				feature.id = nextId++;
+				feature.pt = c(corners[i]);
+				feature.status = Feature_Seeded;
+				feature.age = 0;
+				features.push_back(feature);
+			}
+		}
+	}
+
+	/// <summary>
+	/// Detects up to maxPerCell corners in every empty cell, cells are independent parallel stripes
+	/// </summary>
+	class DetectInvoker : public cv::ParallelLoopBody
+	{
+	public:
+		DetectInvoker(FeatureTracker &owner, const cv::Mat &gray, const cv::Size &cellSize)
+			: owner(owner), gray(gray), cellSize(cellSize)
+		{}
+
+		virtual void operator() (const cv::Range &range) const
+		{
+			std::vector<cv::KeyPoint> keypoints;
+			for (int c = range.start; c < range.end; ++c)
+			{
+				std::vector<cv::Point2f> &corners = owner.seeds[c];
+				corners.clear();
+				if (owner.cellCounts[c] > 0)
+					continue;
+
+				// the last column and row take the remainder
+				const int cx = c % owner.gridCols, cy = c / owner.gridCols;
+				cv::Rect cell(cx * cellSize.width, cy * cellSize.height, cellSize.width, cellSize.height);
+				if (cx == owner.gridCols - 1)
+					cell.width = gray.cols - cell.x;
+				if (cy == owner.gridRows - 1)
+					cell.height = gray.rows - cell.y;
+				const cv::Mat roi = gray(cell);
+
+				if (FeatureTracker_FAST == owner.detector)
+				{
+					keypoints.clear();
+					cv::FAST(roi, keypoints, owner.fastThreshold, true);
+					cv::KeyPointsFilter::retainBest(keypoints, owner.maxPerCell);
+					for (size_t i = 0; i < keypoints.size() && (int)corners.size() < owner.maxPerCell; ++i)
+						corners.push_back(keypoints[i].pt);
+				}
+				else
+				{
+					cv::goodFeaturesToTrack(roi, corners, owner.maxPerCell, owner.qualityLevel, owner.minDistance);
+				}
+
+				for (size_t i = 0; i < corners.size(); ++i)
+					corners[i] += cv::Point2f((float)cell.x, (float)cell.y);
+			}
+		}
+
+	private:
+		FeatureTracker &owner;
+		const cv::Mat &gray;
+		const cv::Size cellSize;
+	};
+
+public:
+	SparseFlowTracker flow;
+
+private:
+	int nextId;
+	int gridCols;
+	int gridRows;
+	int maxPerCell;
+	std::vector<video_TrackedFeature> features;
+
+	// per-frame buffers, reserved once
+	std::vector<cv::Point2f> from;
+	std::vector<cv::Point2f> to;
+	std::vector<cv::Point2f> back;
+	std::vector<uchar> status;
+	std::vector<uchar> backStatus;
+	std::vector<int> cellCounts;
+	std::vector<std::vector<cv::Point2f> > seeds;
+
+public:
+	int detector;
+	double qualityLevel;
+	double minDistance;
+	int fastThreshold;
+	float fbThreshold;
+	float minCoverage;
+};
+
+//------------------------------------------------------------------------------------------------------
+// C-wrapper
+//------------------------------------------------------------------------------------------------------
+
+/// <summary>
+/// Allocates new tracker
+/// </summary>
+/// <param name="winSize">LK search window size at each pyramid level</param>
+/// <param name="maxLevel">LK 0-based maximal pyramid level number</param>
+CVAPI(FeatureTracker*) video_FeatureTracker_new(MyCvSize winSize, int maxLevel)
+{
+	return new FeatureTracker(cpp(winSize), maxLevel);
+}
+
+CVAPI(void) video_FeatureTracker_delete(FeatureTracker *obj)
+{
+	delete obj;
+}
+
+/// <summary>
+/// Seeding grid, drops all the features
+/// </summary>
+/// <param name="cols">Grid columns</param>
+/// <param name="rows">Grid rows</param>
+/// <param name="maxPerCell">Maximum number of corners seeded per cell</param>
+CVAPI(void) video_FeatureTracker_setGrid(FeatureTracker *obj, int cols, int rows, int maxPerCell)
+{
+	obj->setGrid(std::max(1, cols), std::max(1, rows), std::max(1, maxPerCell));
+}
+
+/// <summary>
+/// Corners detector parameters
+/// </summary>
+/// <param name="detector">0 - goodFeaturesToTrack, 1 - FAST</param>
+/// <param name="qualityLevel">goodFeaturesToTrack quality level</param>
+/// <param name="minDistance">goodFeaturesToTrack minimum distance between corners</param>
+/// <param name="fastThreshold">FAST threshold</param>
+CVAPI(void) video_FeatureTracker_setDetector(FeatureTracker *obj, int detector, double qualityLevel, double minDistance, int fastThreshold)
+{
+	obj->detector = (FeatureTracker_FAST == detector) ? FeatureTracker_FAST : FeatureTracker_GFTT;
+	obj->qualityLevel = std::max(1e-6, qualityLevel);
+	obj->minDistance = std::max(0.0, minDistance);
+	obj->fastThreshold = std::max(1, fastThreshold);
+}
+
+/// <summary>
+/// Tracking parameters
+/// </summary>
+/// <param name="fbThreshold">Maximum forward-backward error, pixels</param>
+/// <param name="minCoverage">Share of occupied grid cells [0, 1] below which empty cells are re-seeded</param>
+CVAPI(void) video_FeatureTracker_setTracking(FeatureTracker *obj, MyCvTermCriteria criteria, float minEigThreshold, float fbThreshold, float minCoverage)
+{
+	obj->flow.criteria = cpp(criteria);
+	obj->flow.minEigThreshold = minEigThreshold;
+	obj->fbThreshold = std::max(0.f, fbThreshold);
+	obj->minCoverage = std::min(std::max(minCoverage, 0.f), 1.f);
+}
+
+CVAPI(int) video_FeatureTracker_capacity(FeatureTracker *obj)
+{
+	return obj->capacity();
+}
+
+/// <summary>
+/// Tracks features to the frame, re-seeds the grid if required
+/// </summary>
+/// <param name="image">[in] 8-bit grayscale, BGR or BGRA frame</param>
+/// <param name="output">[out] Features, including the ones lost on this frame; video_FeatureTracker_capacity items fit all of them</param>
+/// <param name="length">Output length</param>
+/// <returns>Number of features, only the first length of them are written</returns>
+CVAPI(int) video_FeatureTracker_process(FeatureTracker *obj, cv::Mat *image, video_TrackedFeature *output, int length)
+{
+	const std::vector<video_TrackedFeature> &features = obj->process(*image);
+	if (nullptr != output)
+		std::copy(features.begin(), features.begin() + std::min((int)features.size(), std::max(length, 0)), output);
+	return (int)features.size();
+}
+
+CVAPI(void) video_FeatureTracker_reset(FeatureTracker *obj)
+{
+	obj->reset();
+}
+
+#pragma endregion
+
+#endif
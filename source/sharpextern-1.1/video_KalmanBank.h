@@ -0,0 +1,222 @@
+#ifndef _CPP_VIDEO_KALMANBANK_H_
+#define _CPP_VIDEO_KALMANBANK_H_
+
+#include "include_opencv.h"
+
+#include <opencv2/core/hal/intrin.hpp>
+
+//------------------------------------------------------------------------------------------------------
+// Kalman filters bank
+//
+// Thousands of independent constant-velocity Kalman filters over scalar channels (i.e. point coordinates,
+// x and y are separate channels) sharing one model: transition is [1 dt; 0 1], process noise is the
+// white acceleration one, measurement is the position. With the model shared, every filter is reduced
+// to 5 floats (position, velocity and 3 unique covariance values), stored as separate arrays, so a
+// predict+correct step runs 4 filters at a time with OpenCV universal intrinsics (SSE2 / NEON)
+//------------------------------------------------------------------------------------------------------
+
+#pragma region KalmanBank
+
+class KalmanBank
+{
+public:
+	KalmanBank(int count)
+		: count(count), initialized(false), dt(1.f), processNoise(1e-2f), measurementNoise(1.f),
+		  pos(count), vel(count), p00(count), p01(count), p11(count)
+	{}
+
+	/// <summary>
+	/// Sets filters state: positions from the measurements, zero velocities, covariance matching measurement noise
+	/// </summary>
+	void reset(const float *measurements)
+	{
+		const float initialVelocityVariance = 1e3f * measurementNoise;
+		for (int i = 0; i < count; ++i)
+		{
+			pos[i] = measurements[i];
+			vel[i] = 0;
+			p00[i] = measurementNoise;
+			p01[i] = 0;
+			p11[i] = initialVelocityVariance;
+		}
+		initialized = true;
+	}
+
+	/// <summary>
+	/// Predict + correct for every filter, the first call initializes the bank. NaN measurements mean "no
+	/// measurement", such filters are predicted only. Filters with no state yet (NaN) start at their measurements
+	/// </summary>
+	/// <param name="output">Filtered positions, might be null</param>
+	void process(const float *measurements, float *output)
+	{
+		if (!initialized)
+		{
+			reset(measurements);
+			if (nullptr != output)
+				std::copy(pos.begin(), pos.end(), output);
+			return;
+		}
+
+		// shared model
+		const float q00 = processNoise * dt * dt * dt * dt * 0.25f;
+		const float q01 = processNoise * dt * dt * dt * 0.5f;
+		const float q11 = processNoise * dt * dt;
+		const float r = measurementNoise;
+		const float initialVelocityVariance = 1e3f * r;
+
+		float *x = pos.data(), *v = vel.data(), *c00 = p00.data(), *c01 = p01.data(), *c11 = p11.data();
+		int i = 0;
+#if CV_SIMD128
+		const cv::v_float32x4 vdt = cv::v_setall_f32(dt), vq00 = cv::v_setall_f32(q00), vq01 = cv::v_setall_f32(q01), vq11 = cv::v_setall_f32(q11);
+		const cv::v_float32x4 vr = cv::v_setall_f32(r), vinit = cv::v_setall_f32(initialVelocityVariance);
+		const cv::v_float32x4 zero = cv::v_setzero_f32(), one = cv::v_setall_f32(1.f), two = cv::v_setall_f32(2.f);
+		for (; i <= count - 4; i += 4)
+		{
+			cv::v_float32x4 z = cv::v_load(measurements + i), xi = cv::v_load(x + i), vi = cv::v_load(v + i);
+			cv::v_float32x4 has = z == z;
+			cv::v_float32x4 fresh = has & ~(xi == xi);
+			z = cv::v_select(has, z, zero);
+			cv::v_float32x4 x0 = cv::v_select(fresh, z, xi);
+			cv::v_float32x4 v0 = cv::v_select(fresh, zero, vi);
+
+			cv::v_float32x4 a00 = cv::v_load(c00 + i), a01 = cv::v_load(c01 + i), a11 = cv::v_load(c11 + i);
+			cv::v_float32x4 xp = x0 + v0 * vdt;
+			cv::v_float32x4 a = a00 + vdt * (two * a01 + vdt * a11) + vq00;
+			cv::v_float32x4 b = a01 + vdt * a11 + vq01;
+			cv::v_float32x4 d = a11 + vq11;
+
+			cv::v_float32x4 s = one / (a + vr);
+			cv::v_float32x4 k0 = cv::v_select(has, a * s, zero);
+			cv::v_float32x4 k1 = cv::v_select(has, b * s, zero);
+			cv::v_float32x4 y = cv::v_select(has, z - xp, zero);
+
+			cv::v_store(x + i, xp + k0 * y);
+			cv::v_store(v + i, v0 + k1 * y);
+			cv::v_store(c00 + i, cv::v_select(fresh, vr, (one - k0) * a));
+			cv::v_store(c01 + i, cv::v_select(fresh, zero, (one - k0) * b));
+			cv::v_store(c11 + i, cv::v_select(fresh, vinit, d - k1 * b));
+		}
+#endif
+		for (; i < count; ++i)
+		{
+			// no measurement: NaN, the filter is predicted only; no state yet (NaN too): it starts at the measurement
+			float z = measurements[i];
+			bool has = z == z;
+			bool fresh = has && x[i] != x[i];
+			z = has ? z : 0.f;
+			float x0 = fresh ? z : x[i];
+			float v0 = fresh ? 0.f : v[i];
+
+			// predict
+			float xp = x0 + v0 * dt;
+			float a = c00[i] + dt * (2.f * c01[i] + dt * c11[i]) + q00;
+			float b = c01[i] + dt * c11[i] + q01;
+			float d = c11[i] + q11;
+
+			// correct, gains are zero when there is no measurement
+			float s = 1.f / (a + r);
+			float k0 = has ? a * s : 0.f;
+			float k1 = has ? b * s : 0.f;
+			float y = has ? z - xp : 0.f;
+
+			x[i] = xp + k0 * y;
+			v[i] = v0 + k1 * y;
+			c00[i] = fresh ? r : (1.f - k0) * a;
+			c01[i] = fresh ? 0.f : (1.f - k0) * b;
+			c11[i] = fresh ? initialVelocityVariance : d - k1 * b;
+		}
+
+		if (nullptr != output)
+			std::copy(pos.begin(), pos.end(), output);
+	}
+
+public:
+	const int count;
+	bool initialized;
+
+	// model
+	float dt;
+	float processNoise;
+	float measurementNoise;
+
+	// state, structure of arrays
+	std::vector<float> pos;
+	std::vector<float> vel;
+	std::vector<float> p00;
+	std::vector<float> p01;
+	std::vector<float> p11;
+};
+
+//------------------------------------------------------------------------------------------------------
+// C-wrapper
+//------------------------------------------------------------------------------------------------------
+
+/// <summary>
+/// Allocates new bank of count filters, it's initialized by the first process call
+/// </summary>
+CVAPI(KalmanBank*) video_KalmanBank_new(int count)
+{
+	return new KalmanBank(std::max(0, count));
+}
+
+CVAPI(void) video_KalmanBank_delete(KalmanBank *obj)
+{
+	delete obj;
+}
+
+CVAPI(int) video_KalmanBank_count(KalmanBank *obj)
+{
+	return obj->count;
+}
+
+/// <summary>
+/// Shared model parameters
+/// </summary>
+/// <param name="dt">Time step between measurements</param>
+/// <param name="processNoise">Acceleration variance, the bigger it is the faster filters follow measurements</param>
+/// <param name="measurementNoise">Measurement variance</param>
+CVAPI(void) video_KalmanBank_setParams(KalmanBank *obj, float dt, float processNoise, float measurementNoise)
+{
+	obj->dt = dt;
+	obj->processNoise = std::max(0.f, processNoise);
+	obj->measurementNoise = std::max(FLT_EPSILON, measurementNoise);
+}
+
+/// <summary>
+/// Re-initializes filters from the measurements, null makes the next process call do that
+/// </summary>
+CVAPI(void) video_KalmanBank_reset(KalmanBank *obj, const float *measurements)
+{
+	if (nullptr != measurements)
+		obj->reset(measurements);
+	else
+		obj->initialized = false;
+}
+
+/// <summary>
+/// Predict + correct step for every filter
+/// </summary>
+/// <param name="measurements">[in] count values, NaN for missing measurements</param>
+/// <param name="output">[out] count filtered values, might be null</param>
+/// <param name="length">Measurements (and output) length, must match filters count</param>
+/// <returns>False if length doesn't match</returns>
+CVAPI(int) video_KalmanBank_process(KalmanBank *obj, const float *measurements, float *output, int length)
+{
+	if (length != obj->count)
+		return 0;
+
+	obj->process(measurements, output);
+	return 1;
+}
+
+/// <summary>
+/// Copies filters velocities, count values
+/// </summary>
+CVAPI(void) video_KalmanBank_getVelocities(KalmanBank *obj, float *output)
+{
+	std::copy(obj->vel.begin(), obj->vel.end(), output);
+}
+
+#pragma endregion
+
+#endif
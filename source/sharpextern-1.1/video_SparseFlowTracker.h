@@ -0,0 +1,172 @@
+#ifndef _CPP_VIDEO_SPARSEFLOWTRACKER_H_
+#define _CPP_VIDEO_SPARSEFLOWTRACKER_H_
+
+#include "include_opencv.h"
+
+//------------------------------------------------------------------------------------------------------
+// Sparse flow tracker
+//
+// Stateful cv::calcOpticalFlowPyrLK for continuous video: pyramid of every frame is built once (with
+// derivatives) and kept as the "previous" one for the next frame, while calcOpticalFlowPyrLK on plain
+// images builds both pyramids on every call. Pyramid buffers are swapped between frames, not reallocated
+//------------------------------------------------------------------------------------------------------
+
+#pragma region SparseFlowTracker
+
+class SparseFlowTracker
+{
+public:
+	SparseFlowTracker(const cv::Size &winSize, int maxLevel, const cv::TermCriteria &criteria, int flags, double minEigThreshold)
+		: winSize(winSize), maxLevel(maxLevel), criteria(criteria), flags(flags), minEigThreshold(minEigThreshold), hasPrevious(false), levels(0)
+	{}
+
+	/// <summary>
+	/// Builds pyramid of the new frame, call commit() once done with it
+	/// </summary>
+	/// <param name="image">8-bit grayscale, BGR or BGRA image</param>
+	/// <returns>False if there is no previous frame to track from</returns>
+	bool push(const cv::Mat &image)
+	{
+		const cv::Mat *source = &image;
+		if (image.channels() > 1)
+		{
+			cv::cvtColor(image, gray, (image.channels() == 4) ? CV_BGRA2GRAY : CV_BGR2GRAY);
+			source = &gray;
+		}
+
+		// level 0 is copied: callers tend to reuse frame buffers and it's kept for the next frame
+		levels = cv::buildOpticalFlowPyramid(*source, next, winSize, maxLevel, true, cv::BORDER_REFLECT_101, cv::BORDER_CONSTANT, false);
+
+		// pyramids of different frame sizes don't match
+		if (source->size() != frameSize)
+			hasPrevious = false;
+		frameSize = source->size();
+		return hasPrevious;
+	}
+
+	/// <summary>
+	/// Sparse flow between the previous and the pushed frames (or backwards)
+	/// </summary>
+	/// <param name="from">Points to track, Nx1 CV_32FC2</param>
+	/// <param name="to">[in/out] Tracked points, initial estimations with OPTFLOW_USE_INITIAL_FLOW</param>
+	void flow(bool backward, const cv::Mat &from, cv::Mat &to, cv::Mat &status, const cv::_OutputArray &err)
+	{
+		cv::calcOpticalFlowPyrLK(backward ? next : prev, backward ? prev : next, from, to, status, err,
+			winSize, levels, criteria, flags, minEigThreshold);
+	}
+
+	/// <summary>
+	/// Grayscale pushed frame, valid until commit()
+	/// </summary>
+	const cv::Mat& frame() const
+	{
+		return next[0];
+	}
+
+	/// <summary>
+	/// Pushed frame becomes the previous one
+	/// </summary>
+	void commit()
+	{
+		std::swap(prev, next);
+		hasPrevious = true;
+	}
+
+	/// <summary>
+	/// Tracks points from the previous frame to the new one, the new one becomes the previous one afterwards
+	/// </summary>
+	/// <returns>False if there was no previous frame, outputs are untouched then</returns>
+	bool track(const cv::Mat &image, const cv::Mat &prevPts, cv::Mat &nextPts, cv::Mat &status, const cv::_OutputArray &err)
+	{
+		bool ready = push(image);
+		if (ready && !prevPts.empty())
+			flow(false, prevPts, nextPts, status, err);
+		commit();
+		return ready;
+	}
+
+	/// <summary>
+	/// Drops the previous frame
+	/// </summary>
+	void reset()
+	{
+		hasPrevious = false;
+	}
+
+public:
+	const cv::Size winSize;
+	const int maxLevel;
+	cv::TermCriteria criteria;
+	int flags;
+	double minEigThreshold;
+
+private:
+	bool hasPrevious;
+	int levels;
+	cv::Size frameSize;
+	std::vector<cv::Mat> prev;
+	std::vector<cv::Mat> next;
+	cv::Mat gray;
+};
+
+//------------------------------------------------------------------------------------------------------
+// C-wrapper
+//------------------------------------------------------------------------------------------------------
+
+/// <summary>
+/// Allocates new tracker, parameters are the same as for cv::calcOpticalFlowPyrLK
+/// </summary>
+CVAPI(SparseFlowTracker*) video_SparseFlowTracker_new(MyCvSize winSize, int maxLevel, MyCvTermCriteria criteria, int flags, double minEigThreshold)
+{
+	return new SparseFlowTracker(cpp(winSize), maxLevel, cpp(criteria), flags, minEigThreshold);
+}
+
+CVAPI(void) video_SparseFlowTracker_delete(SparseFlowTracker *obj)
+{
+	delete obj;
+}
+
+CVAPI(void) video_SparseFlowTracker_setParams(SparseFlowTracker *obj, MyCvTermCriteria criteria, int flags, double minEigThreshold)
+{
+	obj->criteria = cpp(criteria);
+	obj->flags = flags;
+	obj->minEigThreshold = minEigThreshold;
+}
+
+/// <summary>
+/// Tracks points from the previous frame to the given one, which becomes the previous one afterwards
+/// </summary>
+/// <param name="image">[in] 8-bit grayscale, BGR or BGRA frame</param>
+/// <param name="prevPts">[in] Points on the previous frame</param>
+/// <param name="count">Number of points</param>
+/// <param name="nextPts">[in/out] count tracked points, initial estimations with OPTFLOW_USE_INITIAL_FLOW</param>
+/// <param name="status">[out] count values, 1 if point has been tracked</param>
+/// <param name="err">[out] count values, tracking error, might be null</param>
+/// <returns>Number of tracked points, -1 if there was no previous frame (the first one just gets stored)</returns>
+CVAPI(int) video_SparseFlowTracker_track(SparseFlowTracker *obj, cv::Mat *image, cv::Point2f *prevPts, int count, cv::Point2f *nextPts, uchar *status, float *err)
+{
+	cv::Mat prevMat, nextMat, statusMat, errMat;
+	if (count > 0)
+	{
+		prevMat = cv::Mat(count, 1, CV_32FC2, prevPts);
+		nextMat = cv::Mat(count, 1, CV_32FC2, nextPts);
+		statusMat = cv::Mat(count, 1, CV_8UC1, status);
+		if (nullptr != err)
+			errMat = cv::Mat(count, 1, CV_32FC1, err);
+	}
+
+	bool tracked = (nullptr != err) ? obj->track(*image, prevMat, nextMat, statusMat, errMat) : obj->track(*image, prevMat, nextMat, statusMat, cv::noArray());
+	if (!tracked)
+		return -1;
+
+	return (count > 0) ? cv::countNonZero(statusMat) : 0;
+}
+
+CVAPI(void) video_SparseFlowTracker_reset(SparseFlowTracker *obj)
+{
+	obj->reset();
+}
+
+#pragma endregion
+
+#endif
@@ -0,0 +1,109 @@
+﻿using System;
+using System.Runtime.InteropServices;
+
+namespace OpenCvSharp
+{
+	/// <summary>
+	/// Single face detected by dlib, native dlib_FaceDetection layout
+	/// </summary>
+	[StructLayout(LayoutKind.Sequential)]
+	public struct FaceDetection
+	{
+		/// <summary>
+		/// Face rect
+		/// </summary>
+		public Rect Rect;
+
+		/// <summary>
+		/// Detection confidence, the higher the better
+		/// </summary>
+		public double Confidence;
+
+		/// <summary>
+		/// Index of the frontal detector sub-model (face pose) that found the face
+		/// </summary>
+		public int WeightIndex;
+	}
+
+	/// <summary>
+	/// dlib HOG frontal face detector, scans pyramid levels in parallel
+	/// </summary>
+	public class FaceDetector : DisposableCvObject
+	{
+		/// <summary>
+		/// Separate flag from the superclass as we might have our own branch of de-initialization
+		/// </summary>
+		private bool disposed;
+
+		/// <summary>
+		/// Creates new face detector
+		/// </summary>
+		/// <param name="threads">Max pyramid levels scanned in parallel, 0 to match OpenCV threads number</param>
+		public FaceDetector(int threads = 0)
+			: base()
+		{
+			ptr = NativeMethods.dlib_faceDetector_new(threads);
+		}
+
+		/// <summary>
+		/// Releases the resources
+		/// </summary>
+		/// <param name="disposing">
+		/// If disposing equals true, the method has been called directly or indirectly by a user's code. Managed and unmanaged resources can be disposed.
+		/// If false, the method has been called by the runtime from inside the finalizer and you should not reference other objects. Only unmanaged resources can be disposed.
+		/// </param>
+		protected override void Dispose(bool disposing)
+		{
+			if (!disposed)
+			{
+				try
+				{
+					if (ptr != IntPtr.Zero)
+					{
+						NativeMethods.dlib_faceDetector_delete(ptr);
+						ptr = IntPtr.Zero;
+					}
+					disposed = true;
+				}
+				finally
+				{
+					base.Dispose(disposing);
+				}
+			}
+		}
+
+		/// <summary>
+		/// Sets detection parameters
+		/// </summary>
+		/// <param name="upsample">Number of times image is upsampled 2x before scanning, required for faces smaller than 80x80</param>
+		/// <param name="minFaceSize">Smaller faces are not searched for, 0 to search down to 80 / 2^upsample, values of 80 and above cancel upsample</param>
+		/// <param name="pyramidDownscale">Scale between pyramid levels, (0, 1)</param>
+		/// <param name="adjustThreshold">Detection threshold adjustment, negative values give more (less confident) detections</param>
+		public void SetParams(int upsample = 0, int minFaceSize = 0, double pyramidDownscale = 5.0 / 6.0, double adjustThreshold = 0.0)
+		{
+			ThrowIfDisposed();
+			NativeMethods.dlib_faceDetector_setParams(ptr, upsample, minFaceSize, pyramidDownscale, adjustThreshold);
+		}
+
+		/// <summary>
+		/// Detects faces
+		/// </summary>
+		/// <param name="image">8-bit grayscale or BGR image</param>
+		/// <returns>Detected faces ordered by confidence</returns>
+		public FaceDetection[] Detect(Mat image)
+		{
+			ThrowIfDisposed();
+			if (null == image)
+				throw new ArgumentNullException("image");
+
+			IntPtr results;
+			int count = NativeMethods.dlib_faceDetector_detect(ptr, image.CvPtr, out results);
+
+			FaceDetection[] faces = new FaceDetection[count];
+			int size = Marshal.SizeOf(typeof(FaceDetection));
+			for (int i = 0; i < count; ++i)
+				faces[i] = (FaceDetection)Marshal.PtrToStructure(new IntPtr(results.ToInt64() + i * size), typeof(FaceDetection));
+			return faces;
+		}
+	}
+}
@@ -9,13 +9,40 @@ namespace OpenCvSharp
 		public static extern IntPtr dlib_shapePredictor_new();
 
 		[DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
-		public static extern void dlib_shapePredictor_loadData(IntPtr predictor, Byte[] data, int dataSize);
+		public static extern int dlib_shapePredictor_loadData(IntPtr predictor, Byte[] data, int dataSize);
+
+		[DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+		public static extern IntPtr dlib_shapePredictor_loadShared([MarshalAs(UnmanagedType.LPStr)] string fileName);
+
+		[DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+		public static extern IntPtr dlib_shapePredictor_loadSharedData(Byte[] data, int dataSize);
+
+		[DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+		public static extern void dlib_shapePredictor_getCacheStats(out int models, out int handles, out ulong residentBytes, out double lastLoadTime, out double totalLoadTime);
 
 		[DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
 		[return: MarshalAs(UnmanagedType.I1)]
 		public static extern bool dlib_shapePredictor_detectLandmarks(IntPtr predictor, IntPtr image, Rect roi, ref IntPtr landmarks);
 
+		[DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+		public static extern int dlib_shapePredictor_numParts(IntPtr predictor);
+
+		[DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+		public static extern int dlib_shapePredictor_detectLandmarksBatch(IntPtr predictor, IntPtr image, Rect[] rois, int roisCount, int[] output, int outputLength, int[] offsets);
+
 		[DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
 		public static extern void dlib_shapePredictor_delete(IntPtr instance);
+
+		[DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+		public static extern IntPtr dlib_faceDetector_new(int threads);
+
+		[DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+		public static extern void dlib_faceDetector_setParams(IntPtr detector, int upsample, int minFaceSize, double pyramidDownscale, double adjustThreshold);
+
+		[DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+		public static extern int dlib_faceDetector_detect(IntPtr detector, IntPtr image, out IntPtr results);
+
+		[DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+		public static extern void dlib_faceDetector_delete(IntPtr detector);
 	}
 }
\ No newline at end of file
@@ -8,6 +8,37 @@ namespace OpenCvSharp
 	/// </summary>
 	public class ShapePredictor : DisposableCvObject
 	{
+		/// <summary>
+		/// Shared models cache statistics
+		/// </summary>
+		public struct CacheStats
+		{
+			/// <summary>
+			/// Number of distinct models deserialized
+			/// </summary>
+			public int Models;
+
+			/// <summary>
+			/// Number of live shared predictor handles
+			/// </summary>
+			public int Handles;
+
+			/// <summary>
+			/// Approximate memory held by shared models, the sum of their serialized sizes (models are deserialized in full, not lazily)
+			/// </summary>
+			public ulong ResidentBytes;
+
+			/// <summary>
+			/// The latest model deserialization time, ms
+			/// </summary>
+			public double LastLoadTime;
+
+			/// <summary>
+			/// Total models deserialization time, ms
+			/// </summary>
+			public double TotalLoadTime;
+		}
+
 		/// <summary>
 		/// Separate flag from the superclass as we might have our own branch of de-initialization
 		/// </summary>
@@ -22,6 +53,56 @@ namespace OpenCvSharp
 			ptr = NativeMethods.dlib_shapePredictor_new();
 		}
 
+		/// <summary>
+		/// Wraps existing native predictor
+		/// </summary>
+		private ShapePredictor(IntPtr predictor)
+			: base()
+		{
+			ptr = predictor;
+		}
+
+		/// <summary>
+		/// Loads shared predictor from the model file. File is memory mapped, models with the same content are
+		/// deserialized once per process and shared by all predictors, LoadData throws on shared predictors
+		/// </summary>
+		/// <param name="fileName">Serialized model file path</param>
+		public static ShapePredictor LoadShared(string fileName)
+		{
+			if (String.IsNullOrEmpty(fileName))
+				throw new ArgumentNullException("fileName");
+
+			IntPtr predictor = NativeMethods.dlib_shapePredictor_loadShared(fileName);
+			if (IntPtr.Zero == predictor)
+				throw new OpenCvSharpException("Failed to load shape predictor from \"{0}\"", fileName);
+			return new ShapePredictor(predictor);
+		}
+
+		/// <summary>
+		/// Loads shared predictor from the in-memory model, see LoadShared(string)
+		/// </summary>
+		/// <param name="data">Serialized model</param>
+		public static ShapePredictor LoadShared(Byte[] data)
+		{
+			if (null == data || 0 == data.Length)
+				throw new ArgumentNullException("data");
+
+			IntPtr predictor = NativeMethods.dlib_shapePredictor_loadSharedData(data, data.Length);
+			if (IntPtr.Zero == predictor)
+				throw new OpenCvSharpException("Failed to load shape predictor data");
+			return new ShapePredictor(predictor);
+		}
+
+		/// <summary>
+		/// Shared models statistics
+		/// </summary>
+		public static CacheStats GetCacheStats()
+		{
+			CacheStats stats;
+			NativeMethods.dlib_shapePredictor_getCacheStats(out stats.Models, out stats.Handles, out stats.ResidentBytes, out stats.LastLoadTime, out stats.TotalLoadTime);
+			return stats;
+		}
+
 		/// <summary>
 		/// Releases the resources
 		/// </summary>
@@ -60,13 +141,17 @@ namespace OpenCvSharp
 		/// <param name="array">Input data stream</param>
 		public void LoadData(Byte[] data)
 		{
-			NativeMethods.dlib_shapePredictor_loadData(ptr, data, data.Length);
+			if (null == data)
+				throw new ArgumentNullException("data");
+
+			if (NativeMethods.dlib_shapePredictor_loadData(ptr, data, data.Length) < 0)
+				throw new OpenCvSharpException("Failed to load shape predictor data: predictor is shared (immutable) or data is not a model");
 		}
 
 		/// <summary>
 		/// Detects landmarks on the image
 		/// </summary>
-		/// <param name="image">Input image</param>
+		/// <param name="image">Input image: CV_8UC1, CV_8UC3 (BGR) or CV_8UC4 (BGRA), color images are used as is, without gray conversion</param>
 		/// <param name="roi">Region of interest</param>
 		/// <returns>Landmark points</returns>
 		public Point[] DetectLandmarks(Mat image, Rect roi)
@@ -82,5 +167,48 @@ namespace OpenCvSharp
 
 			return new Point[0];
 		}
+
+		/// <summary>
+		/// Number of landmarks detected per face
+		/// </summary>
+		public int NumParts
+		{
+			get
+			{
+				ThrowIfDisposed();
+				return NativeMethods.dlib_shapePredictor_numParts(ptr);
+			}
+		}
+
+		/// <summary>
+		/// Detects landmarks for several faces at once (in parallel), writes them into the pre-allocated buffer
+		/// </summary>
+		/// <param name="image">Input image: CV_8UC1, CV_8UC3 (BGR) or CV_8UC4 (BGRA), color images are used as is, without gray conversion</param>
+		/// <param name="rois">Faces regions</param>
+		/// <param name="roisCount">Number of regions to process from the rois array</param>
+		/// <param name="output">Output buffer, receives (x, y) pairs face after face, must fit roisCount * NumParts * 2 values</param>
+		/// <param name="offsets">Optional, receives index of each face first point (in points, not values)</param>
+		/// <returns>Number of points written</returns>
+		public int DetectLandmarks(Mat image, Rect[] rois, int roisCount, int[] output, int[] offsets = null)
+		{
+			ThrowIfDisposed();
+			if (null == image)
+				throw new ArgumentNullException("image");
+			MatType type = image.Type();
+			if (type != MatType.CV_8UC1 && type != MatType.CV_8UC3 && type != MatType.CV_8UC4)
+				throw new ArgumentException("image must be CV_8UC1, CV_8UC3 or CV_8UC4");
+			if (roisCount < 0)
+				throw new ArgumentOutOfRangeException("roisCount");
+			if (null == rois || roisCount > rois.Length)
+				throw new ArgumentException("rois must contain at least roisCount items");
+			if (null != offsets && offsets.Length < roisCount)
+				throw new ArgumentException("offsets must contain at least roisCount items");
+
+			int count = NativeMethods.dlib_shapePredictor_detectLandmarksBatch(ptr, image.CvPtr, rois, roisCount, output, null != output ? output.Length : 0, offsets);
+			if (count < 0)
+				throw new ArgumentException("invalid arguments: image must not be empty and output must fit roisCount * NumParts * 2 values");
+
+			return count;
+		}
 	}
 }
@@ -146,6 +146,79 @@ namespace OpenCvSharp
 
         #endregion
 
+        #region MarkerTracker
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern IntPtr aruco_MarkerTracker_new(IntPtr dictionary, IntPtr parameters);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern void aruco_MarkerTracker_delete(IntPtr obj);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern void aruco_MarkerTracker_setParameters(IntPtr obj, IntPtr parameters);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern void aruco_MarkerTracker_setTrackingParams(IntPtr obj, int rescanInterval, double roiPadding);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern void aruco_MarkerTracker_setPyramidScale(IntPtr obj, double pyramidScale);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern double aruco_MarkerTracker_getPyramidScale(IntPtr obj);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern int aruco_MarkerTracker_track(IntPtr obj, IntPtr image, IntPtr corners, IntPtr ids);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern void aruco_MarkerTracker_reset(IntPtr obj);
+
+        #endregion
+
+        #region MarkerPoseTracker
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern IntPtr aruco_MarkerPoseTracker_new(IntPtr dictionary, IntPtr parameters, float markerLength,
+            [MarshalAs(UnmanagedType.LPArray)] double[] cameraMatrix, [MarshalAs(UnmanagedType.LPArray)] double[] distCoeffs, int distCoeffsLength);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern void aruco_MarkerPoseTracker_delete(IntPtr obj);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern void aruco_MarkerPoseTracker_setParameters(IntPtr obj, IntPtr parameters);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern void aruco_MarkerPoseTracker_setTrackingParams(IntPtr obj, int rescanInterval, double roiPadding, double pyramidScale);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern void aruco_MarkerPoseTracker_setSmoothing(IntPtr obj, double smoothing, int maxMissedFrames);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern int aruco_MarkerPoseTracker_process(IntPtr obj, IntPtr image, [Out] Aruco.MarkerPose[] output, int outputLength);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern void aruco_MarkerPoseTracker_reset(IntPtr obj);
+
+        #endregion
+
+        #region DictionaryIndex
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern IntPtr aruco_DictionaryIndex_new(IntPtr dictionary);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern void aruco_DictionaryIndex_delete(IntPtr obj);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern int aruco_DictionaryIndex_size(IntPtr obj);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern int aruco_DictionaryIndex_identify(IntPtr obj, IntPtr onlyBits, double maxCorrectionRate, out int idx, out int rotation);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern int aruco_DictionaryIndex_identifyBatch(IntPtr obj, [In] ulong[] codes, int count, double maxCorrectionRate, [Out] int[] ids, [Out] int[] rotations);
+
+        #endregion
+
     }
 
 }
@@ -206,5 +206,36 @@ namespace OpenCvSharp
         [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
         public static extern void objdetect_groupRectangles_meanshift(
             IntPtr rectList, IntPtr foundWeights, IntPtr foundScales, double detectThreshold, Size winDetSize);
+
+        #region CascadeDetector
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr objdetect_CascadeDetector_new(int threads);
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void objdetect_CascadeDetector_delete(IntPtr obj);
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int objdetect_CascadeDetector_getThreads(IntPtr obj);
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int objdetect_CascadeDetector_readFaceCascade(IntPtr obj, IntPtr node);
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int objdetect_CascadeDetector_loadFaceCascade(IntPtr obj, [MarshalAs(UnmanagedType.LPStr)] string fileName);
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int objdetect_CascadeDetector_readEyesCascade(IntPtr obj, IntPtr node);
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int objdetect_CascadeDetector_loadEyesCascade(IntPtr obj, [MarshalAs(UnmanagedType.LPStr)] string fileName);
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void objdetect_CascadeDetector_setFaceParams(IntPtr obj, double scaleFactor, int minNeighbors, Size minSize, Size maxSize);
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void objdetect_CascadeDetector_setEyesParams(IntPtr obj, double scaleFactor, int minNeighbors, Size minSize, int minEyes, int maxEyes, int rejectUnconfirmed);
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int objdetect_CascadeDetector_detect(IntPtr obj, IntPtr image, out IntPtr results);
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void objdetect_CascadeDetector_setTrackingParams(IntPtr obj, int rescanInterval, double roiExpand, double scaleBand);
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int objdetect_CascadeDetector_track(IntPtr obj, IntPtr image, out IntPtr results, out int fullScan);
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void objdetect_CascadeDetector_resetTracking(IntPtr obj);
+
+        #endregion
     }
 }
\ No newline at end of file
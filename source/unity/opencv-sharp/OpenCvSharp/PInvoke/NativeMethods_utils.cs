@@ -0,0 +1,137 @@
+﻿using System;
+using System.Runtime.InteropServices;
+
+#pragma warning disable 1591
+
+namespace OpenCvSharp
+{
+    [StructLayout(LayoutKind.Sequential)]
+    public struct FramePipelineResult
+    {
+        public long FrameId;
+        public double ProcessingTime;
+        public int FacesCount;
+        public IntPtr Faces;
+        public int PartsPerFace;
+        public IntPtr Landmarks;
+        public int MarkersCount;
+        public IntPtr MarkerIds;
+        public IntPtr MarkerCorners;
+        private int error;
+
+        /// <summary>
+        /// True if the frame could not be processed, FrameId is -1 then
+        /// </summary>
+        public bool Error
+        {
+            get { return error != 0; }
+        }
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct BackgroundRunnerResult
+    {
+        public long FrameId;
+        public double ProcessingTime;
+        public double WaitTime;
+        private int error;
+
+        /// <summary>
+        /// True if the frame could not be processed, FrameId is -1 then
+        /// </summary>
+        public bool Error
+        {
+            get { return error != 0; }
+        }
+    }
+
+    static partial class NativeMethods
+    {
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern IntPtr utils_FramePipeline_new();
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern void utils_FramePipeline_delete(IntPtr obj);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern int utils_FramePipeline_readFaceCascade(IntPtr obj, IntPtr node);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern void utils_FramePipeline_setFaceDetection(IntPtr obj, double scaleFactor, int minNeighbors, Size minSize, int equalizeHist);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern void utils_FramePipeline_setShapePredictor(IntPtr obj, IntPtr predictor);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern void utils_FramePipeline_setMarkerDetection(IntPtr obj, IntPtr dictionary, IntPtr parameters);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern void utils_FramePipeline_start(IntPtr obj);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern void utils_FramePipeline_stop(IntPtr obj);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern long utils_FramePipeline_submitTexture(IntPtr obj, IntPtr pixels32, int w, int h, [MarshalAs(UnmanagedType.I1)] bool flipVertically, [MarshalAs(UnmanagedType.I1)] bool flipHorizontally, int rotationAngle);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern long utils_FramePipeline_submitMat(IntPtr obj, IntPtr image);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern int utils_FramePipeline_poll(IntPtr obj, out FramePipelineResult result);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern IntPtr utils_BackgroundRunner_new();
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern void utils_BackgroundRunner_delete(IntPtr obj);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern int utils_BackgroundRunner_addMOG2(IntPtr obj, int history, double varThreshold, int detectShadows);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern int utils_BackgroundRunner_addKNN(IntPtr obj, int history, double dist2Threshold, int detectShadows);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern int utils_BackgroundRunner_streamsCount(IntPtr obj);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern void utils_BackgroundRunner_setLearningRate(IntPtr obj, int stream, double learningRate);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern void utils_BackgroundRunner_start(IntPtr obj, int threads);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern void utils_BackgroundRunner_stop(IntPtr obj);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern long utils_BackgroundRunner_submitTexture(IntPtr obj, int stream, IntPtr pixels32, int w, int h, [MarshalAs(UnmanagedType.I1)] bool flipVertically, [MarshalAs(UnmanagedType.I1)] bool flipHorizontally, int rotationAngle);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern long utils_BackgroundRunner_submitMat(IntPtr obj, int stream, IntPtr image);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern int utils_BackgroundRunner_poll(IntPtr obj, int stream, IntPtr mask, out BackgroundRunnerResult result);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern IntPtr utils_LandmarkStabilizer_new();
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern void utils_LandmarkStabilizer_delete(IntPtr obj);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern void utils_LandmarkStabilizer_setOneEuro(IntPtr obj, float minCutoff, float beta, float derivativeCutoff);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern void utils_LandmarkStabilizer_setThreshold(IntPtr obj, float threshold, int samplesCount, int perPoint);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern void utils_LandmarkStabilizer_setMaxMissedFrames(IntPtr obj, int value);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern int utils_LandmarkStabilizer_process(IntPtr obj, [In] int[] points, int facesCount, [In] int[] faceIds, int pointsPerFace, float dt, [Out] float[] output);
+
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl, ExactSpelling = true)]
+        public static extern void utils_LandmarkStabilizer_reset(IntPtr obj);
+    }
+}
@@ -296,5 +296,7 @@ namespace OpenCvSharp
         public static extern void core_randShuffle(IntPtr dst, double iterFactor, ref ulong rng);
         [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
         public static extern void core_randShuffle(IntPtr dst, double iterFactor, IntPtr rng);
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int core_releaseBatch(int[] types, IntPtr[] objects, int count);
     }
 }
\ No newline at end of file
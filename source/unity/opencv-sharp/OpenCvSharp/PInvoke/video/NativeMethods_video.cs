@@ -104,5 +104,69 @@ namespace OpenCvSharp
         public static extern IntPtr video_Ptr_DenseOpticalFlow_get(IntPtr ptr);
         [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
         public static extern void video_Ptr_DenseOpticalFlow_delete(IntPtr ptr);
+
+        // Kalman filters bank
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr video_KalmanBank_new(int count);
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void video_KalmanBank_delete(IntPtr obj);
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int video_KalmanBank_count(IntPtr obj);
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void video_KalmanBank_setParams(IntPtr obj, float dt, float processNoise, float measurementNoise);
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void video_KalmanBank_reset(IntPtr obj, [In] float[] measurements);
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int video_KalmanBank_process(IntPtr obj, [In] float[] measurements, [Out] float[] output, int length);
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void video_KalmanBank_getVelocities(IntPtr obj, [Out] float[] output);
+
+        // Sparse flow tracker
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr video_SparseFlowTracker_new(Size winSize, int maxLevel, TermCriteria criteria, int flags, double minEigThreshold);
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void video_SparseFlowTracker_delete(IntPtr obj);
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void video_SparseFlowTracker_setParams(IntPtr obj, TermCriteria criteria, int flags, double minEigThreshold);
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int video_SparseFlowTracker_track(IntPtr obj, IntPtr image, [In] Point2f[] prevPts, int count, [In, Out] Point2f[] nextPts, [Out] byte[] status, [Out] float[] err);
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void video_SparseFlowTracker_reset(IntPtr obj);
+
+        // Feature tracker
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr video_FeatureTracker_new(Size winSize, int maxLevel);
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void video_FeatureTracker_delete(IntPtr obj);
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void video_FeatureTracker_setGrid(IntPtr obj, int cols, int rows, int maxPerCell);
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void video_FeatureTracker_setDetector(IntPtr obj, int detector, double qualityLevel, double minDistance, int fastThreshold);
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void video_FeatureTracker_setTracking(IntPtr obj, TermCriteria criteria, float minEigThreshold, float fbThreshold, float minCoverage);
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int video_FeatureTracker_capacity(IntPtr obj);
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int video_FeatureTracker_process(IntPtr obj, IntPtr image, [Out] TrackedFeature[] output, int length);
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void video_FeatureTracker_reset(IntPtr obj);
+
+        // Downscaled dense flow
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr video_DownscaledFlow_new();
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void video_DownscaledFlow_delete(IntPtr obj);
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void video_DownscaledFlow_setLevel(IntPtr obj, int level);
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int video_DownscaledFlow_getLevel(IntPtr obj);
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void video_DownscaledFlow_setFarneback(IntPtr obj, double pyrScale, int levels, int winSize, int iterations, int polyN, double polySigma, int flags);
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void video_DownscaledFlow_setAlgorithm(IntPtr obj, IntPtr algorithm);
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int video_DownscaledFlow_process(IntPtr obj, IntPtr image, IntPtr flow, out DenseFlowTimings timings);
+        [DllImport(DllExtern, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void video_DownscaledFlow_reset(IntPtr obj);
     }
 }
\ No newline at end of file
@@ -0,0 +1,177 @@
+﻿using UnityEngine;
+using System;
+using System.Runtime.InteropServices;
+
+namespace OpenCvSharp {
+
+	/// <summary>
+	/// Multi-stream background subtraction: every stream owns a MOG2 or KNN subtractor, frames submitted from the Unity
+	/// thread are processed by a shared pool of native worker threads, masks are polled later without ever waiting for the workers
+	/// </summary>
+	public class BackgroundRunner : DisposableCvObject {
+
+		/// <summary>
+		/// Separate flag from the superclass as we might have our own branch of de-initialization
+		/// </summary>
+		private bool disposed;
+
+		/// <summary>
+		/// Pinned pixels buffer for submitted frames
+		/// </summary>
+		private Color32[] pixels32;
+
+		/// <summary>
+		/// Creates new idle runner with no streams
+		/// </summary>
+		public BackgroundRunner()
+			: base()
+		{
+			ptr = NativeMethods.utils_BackgroundRunner_new();
+		}
+
+		/// <summary>
+		/// Releases the resources
+		/// </summary>
+		/// <param name="disposing">
+		/// If disposing equals true, the method has been called directly or indirectly by a user's code. Managed and unmanaged resources can be disposed.
+		/// If false, the method has been called by the runtime from inside the finalizer and you should not reference other objects. Only unmanaged resources can be disposed.
+		/// </param>
+		protected override void Dispose(bool disposing)
+		{
+			if (!disposed)
+			{
+				try
+				{
+					// native side stops the workers before releasing
+					if (ptr != IntPtr.Zero)
+					{
+						NativeMethods.utils_BackgroundRunner_delete(ptr);
+						ptr = IntPtr.Zero;
+					}
+					disposed = true;
+				}
+				finally
+				{
+					base.Dispose(disposing);
+				}
+			}
+		}
+
+		/// <summary>
+		/// Number of streams
+		/// </summary>
+		public int StreamsCount
+		{
+			get
+			{
+				ThrowIfDisposed();
+				return NativeMethods.utils_BackgroundRunner_streamsCount(ptr);
+			}
+		}
+
+		/// <summary>
+		/// Adds stream with MOG2 subtractor, see BackgroundSubtractorMOG2.Create. Must be called while runner is stopped
+		/// </summary>
+		/// <returns>Stream index, -1 if runner is running</returns>
+		public int AddMOG2(int history = 500, double varThreshold = 16, bool detectShadows = true)
+		{
+			ThrowIfDisposed();
+			return NativeMethods.utils_BackgroundRunner_addMOG2(ptr, history, varThreshold, detectShadows ? 1 : 0);
+		}
+
+		/// <summary>
+		/// Adds stream with KNN subtractor, see BackgroundSubtractorKNN.Create. Must be called while runner is stopped
+		/// </summary>
+		/// <returns>Stream index, -1 if runner is running</returns>
+		public int AddKNN(int history = 500, double dist2Threshold = 400.0, bool detectShadows = true)
+		{
+			ThrowIfDisposed();
+			return NativeMethods.utils_BackgroundRunner_addKNN(ptr, history, dist2Threshold, detectShadows ? 1 : 0);
+		}
+
+		/// <summary>
+		/// Sets stream learning rate, see BackgroundSubtractor.Apply. Must be called while runner is stopped
+		/// </summary>
+		public void SetLearningRate(int stream, double learningRate)
+		{
+			ThrowIfDisposed();
+			NativeMethods.utils_BackgroundRunner_setLearningRate(ptr, stream, learningRate);
+		}
+
+		/// <summary>
+		/// Starts the worker threads
+		/// </summary>
+		/// <param name="threads">Workers count, 0 for one per stream limited by the number of CPUs</param>
+		public void Start(int threads = 0)
+		{
+			ThrowIfDisposed();
+			NativeMethods.utils_BackgroundRunner_start(ptr, threads);
+		}
+
+		/// <summary>
+		/// Stops the worker threads, waits for the frames in progress
+		/// </summary>
+		public void Stop()
+		{
+			ThrowIfDisposed();
+			NativeMethods.utils_BackgroundRunner_stop(ptr);
+		}
+
+		/// <summary>
+		/// Submits the current texture frame to the stream, returns immediately
+		/// </summary>
+		/// <returns>Submitted frame id, -1 if there is no such stream or the texture is empty</returns>
+		public long Submit(int stream, WebCamTexture texture, Unity.TextureConversionParams parameters = null)
+		{
+			ThrowIfDisposed();
+			if (null == parameters)
+				parameters = Unity.TextureConversionParams.Default;
+
+			if (null == pixels32 || pixels32.Length != texture.width * texture.height)
+				pixels32 = texture.GetPixels32();
+			else
+				texture.GetPixels32(pixels32);
+
+			GCHandle gcHandle = GCHandle.Alloc(pixels32, GCHandleType.Pinned);
+			try
+			{
+				return NativeMethods.utils_BackgroundRunner_submitTexture(ptr, stream, gcHandle.AddrOfPinnedObject(), texture.width, texture.height,
+					parameters.FlipVertically, parameters.FlipHorizontally, parameters.RotationAngle);
+			}
+			finally
+			{
+				gcHandle.Free();
+			}
+		}
+
+		/// <summary>
+		/// Submits BGR or grayscale image to the stream, it's copied so the caller may modify it right away
+		/// </summary>
+		/// <returns>Submitted frame id, -1 if there is no such stream or the image is empty or not 8-bit BGR/grayscale</returns>
+		public long Submit(int stream, Mat image)
+		{
+			ThrowIfDisposed();
+			if (null == image)
+				throw new ArgumentNullException("image");
+
+			return NativeMethods.utils_BackgroundRunner_submitMat(ptr, stream, image.CvPtr);
+		}
+
+		/// <summary>
+		/// Takes the latest completed result of the stream
+		/// </summary>
+		/// <param name="stream">Stream index</param>
+		/// <param name="mask">Receives foreground mask if there is a new result, might be null</param>
+		/// <param name="result">Result frame id (as returned by Submit) and timings, the previous result if there is no new one;
+		/// Error is set (and frame id is -1) if the frame could not be processed</param>
+		/// <returns>True if there is a new result since the previous call</returns>
+		public bool Poll(int stream, Mat mask, out BackgroundRunnerResult result)
+		{
+			ThrowIfDisposed();
+
+			int fresh = NativeMethods.utils_BackgroundRunner_poll(ptr, stream, null != mask ? mask.CvPtr : IntPtr.Zero, out result);
+			GC.KeepAlive(mask);
+			return fresh > 0;
+		}
+	}
+}
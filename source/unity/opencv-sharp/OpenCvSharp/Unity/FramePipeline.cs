@@ -0,0 +1,269 @@
+﻿using UnityEngine;
+using System;
+using System.Runtime.InteropServices;
+using OpenCvSharp.Aruco;
+
+namespace OpenCvSharp {
+
+	/// <summary>
+	/// Asynchronous detection pipeline: frames are submitted from the Unity thread and processed by the native
+	/// worker thread (faces, landmarks, markers), results are polled later without ever waiting for the worker
+	/// </summary>
+	public class FramePipeline : DisposableCvObject {
+
+		/// <summary>
+		/// Separate flag from the superclass as we might have our own branch of de-initialization
+		/// </summary>
+		private bool disposed;
+
+		/// <summary>
+		/// Keeps shape predictor alive while pipeline references it
+		/// </summary>
+		private ShapePredictor shapePredictor;
+
+		/// <summary>
+		/// Keep markers detector objects alive while pipeline references them
+		/// </summary>
+		private Dictionary dictionary;
+		private DetectorParameters detectorParameters;
+
+		/// <summary>
+		/// Pinned pixels buffer for submitted frames
+		/// </summary>
+		private Color32[] pixels32;
+
+		/// <summary>
+		/// Detected faces of the latest polled frame
+		/// </summary>
+		public Rect[] Faces { get; private set; }
+
+		/// <summary>
+		/// Landmarks of the latest polled frame, PartsPerFace points per face in the same order as Faces
+		/// </summary>
+		public Point[] Landmarks { get; private set; }
+
+		/// <summary>
+		/// Number of landmarks per face, 0 if no shape predictor is set
+		/// </summary>
+		public int PartsPerFace { get; private set; }
+
+		/// <summary>
+		/// Detected markers ids of the latest polled frame
+		/// </summary>
+		public int[] MarkerIds { get; private set; }
+
+		/// <summary>
+		/// Detected markers corners of the latest polled frame, 4 per marker
+		/// </summary>
+		public Point2f[][] MarkerCorners { get; private set; }
+
+		/// <summary>
+		/// Id of the latest polled frame, -1 if none, as returned by Submit
+		/// </summary>
+		public long FrameId { get; private set; }
+
+		/// <summary>
+		/// Worker processing time of the latest polled frame, ms
+		/// </summary>
+		public double ProcessingTime { get; private set; }
+
+		/// <summary>
+		/// True if the latest polled frame could not be processed, FrameId is -1 and there are no detections then
+		/// </summary>
+		public bool Failed { get; private set; }
+
+		/// <summary>
+		/// Creates new idle pipeline
+		/// </summary>
+		public FramePipeline()
+			: base()
+		{
+			ptr = NativeMethods.utils_FramePipeline_new();
+
+			Faces = new Rect[0];
+			Landmarks = new Point[0];
+			MarkerIds = new int[0];
+			MarkerCorners = new Point2f[0][];
+			FrameId = -1;
+		}
+
+		/// <summary>
+		/// Releases the resources
+		/// </summary>
+		/// <param name="disposing">
+		/// If disposing equals true, the method has been called directly or indirectly by a user's code. Managed and unmanaged resources can be disposed.
+		/// If false, the method has been called by the runtime from inside the finalizer and you should not reference other objects. Only unmanaged resources can be disposed.
+		/// </param>
+		protected override void Dispose(bool disposing)
+		{
+			if (!disposed)
+			{
+				try
+				{
+					// native side stops the worker before releasing
+					if (ptr != IntPtr.Zero)
+					{
+						NativeMethods.utils_FramePipeline_delete(ptr);
+						ptr = IntPtr.Zero;
+					}
+					if (disposing)
+					{
+						shapePredictor = null;
+						dictionary = null;
+						detectorParameters = null;
+					}
+					disposed = true;
+				}
+				finally
+				{
+					base.Dispose(disposing);
+				}
+			}
+		}
+
+		/// <summary>
+		/// Loads face cascade, pipeline keeps its own classifier instance. Must be called while pipeline is stopped
+		/// </summary>
+		/// <param name="node">Root XML node with cascade data</param>
+		/// <returns>True for success, false otherwise</returns>
+		public bool ReadFaceCascade(FileNode node)
+		{
+			ThrowIfDisposed();
+			if (null == node)
+				throw new ArgumentNullException("node");
+
+			return NativeMethods.utils_FramePipeline_readFaceCascade(ptr, node.CvPtr) != 0;
+		}
+
+		/// <summary>
+		/// Sets face detection parameters, see CascadeClassifier.DetectMultiScale. Must be called while pipeline is stopped
+		/// </summary>
+		public void SetFaceDetection(double scaleFactor, int minNeighbors, Size minSize, bool equalizeHist = true)
+		{
+			ThrowIfDisposed();
+			NativeMethods.utils_FramePipeline_setFaceDetection(ptr, scaleFactor, minNeighbors, minSize, equalizeHist ? 1 : 0);
+		}
+
+		/// <summary>
+		/// Sets landmarks detector, null disables landmarks. Must be called while pipeline is stopped,
+		/// predictor must not be used from elsewhere while the pipeline is running
+		/// </summary>
+		public void SetShapePredictor(ShapePredictor predictor)
+		{
+			ThrowIfDisposed();
+			shapePredictor = predictor;
+			NativeMethods.utils_FramePipeline_setShapePredictor(ptr, null != predictor ? predictor.CvPtr : IntPtr.Zero);
+		}
+
+		/// <summary>
+		/// Sets markers detector, null dictionary disables markers. Must be called while pipeline is stopped
+		/// </summary>
+		public void SetMarkerDetection(Dictionary markersDictionary, DetectorParameters parameters = null)
+		{
+			ThrowIfDisposed();
+			dictionary = markersDictionary;
+			detectorParameters = parameters;
+			NativeMethods.utils_FramePipeline_setMarkerDetection(ptr,
+				null != markersDictionary ? markersDictionary.ptrObj.CvPtr : IntPtr.Zero,
+				null != parameters ? parameters.ptrObj.CvPtr : IntPtr.Zero);
+		}
+
+		/// <summary>
+		/// Starts the worker thread
+		/// </summary>
+		public void Start()
+		{
+			ThrowIfDisposed();
+			NativeMethods.utils_FramePipeline_start(ptr);
+		}
+
+		/// <summary>
+		/// Stops the worker thread, waits for the frame in progress
+		/// </summary>
+		public void Stop()
+		{
+			ThrowIfDisposed();
+			NativeMethods.utils_FramePipeline_stop(ptr);
+		}
+
+		/// <summary>
+		/// Submits the current texture frame, returns immediately
+		/// </summary>
+		/// <returns>Submitted frame id, -1 if the texture is empty</returns>
+		public long Submit(WebCamTexture texture, Unity.TextureConversionParams parameters = null)
+		{
+			ThrowIfDisposed();
+			if (null == parameters)
+				parameters = Unity.TextureConversionParams.Default;
+
+			if (null == pixels32 || pixels32.Length != texture.width * texture.height)
+				pixels32 = texture.GetPixels32();
+			else
+				texture.GetPixels32(pixels32);
+
+			GCHandle gcHandle = GCHandle.Alloc(pixels32, GCHandleType.Pinned);
+			try
+			{
+				return NativeMethods.utils_FramePipeline_submitTexture(ptr, gcHandle.AddrOfPinnedObject(), texture.width, texture.height,
+					parameters.FlipVertically, parameters.FlipHorizontally, parameters.RotationAngle);
+			}
+			finally
+			{
+				gcHandle.Free();
+			}
+		}
+
+		/// <summary>
+		/// Submits BGR or grayscale image, it's copied so the caller may modify it right away
+		/// </summary>
+		/// <returns>Submitted frame id, -1 if the image is empty or not 8-bit BGR/grayscale</returns>
+		public long Submit(Mat image)
+		{
+			ThrowIfDisposed();
+			if (null == image)
+				throw new ArgumentNullException("image");
+
+			return NativeMethods.utils_FramePipeline_submitMat(ptr, image.CvPtr);
+		}
+
+		/// <summary>
+		/// Takes the latest completed result into Faces, Landmarks and Markers properties
+		/// </summary>
+		/// <returns>True if there is a new result since the previous call</returns>
+		public bool Poll()
+		{
+			ThrowIfDisposed();
+
+			FramePipelineResult result;
+			if (0 == NativeMethods.utils_FramePipeline_poll(ptr, out result))
+				return false;
+
+			FrameId = result.FrameId;
+			ProcessingTime = result.ProcessingTime;
+			Failed = result.Error;
+			PartsPerFace = result.PartsPerFace;
+
+			Faces = new Rect[result.FacesCount];
+			for (int i = 0; i < Faces.Length; ++i)
+				Faces[i] = (Rect)Marshal.PtrToStructure(new IntPtr(result.Faces.ToInt64() + i * Marshal.SizeOf(typeof(Rect))), typeof(Rect));
+
+			Landmarks = new Point[result.FacesCount * result.PartsPerFace];
+			for (int i = 0; i < Landmarks.Length; ++i)
+				Landmarks[i] = (Point)Marshal.PtrToStructure(new IntPtr(result.Landmarks.ToInt64() + i * Marshal.SizeOf(typeof(Point))), typeof(Point));
+
+			MarkerIds = new int[result.MarkersCount];
+			if (MarkerIds.Length > 0)
+				Marshal.Copy(result.MarkerIds, MarkerIds, 0, MarkerIds.Length);
+
+			MarkerCorners = new Point2f[result.MarkersCount][];
+			for (int i = 0; i < MarkerCorners.Length; ++i)
+			{
+				MarkerCorners[i] = new Point2f[4];
+				for (int j = 0; j < 4; ++j)
+					MarkerCorners[i][j] = (Point2f)Marshal.PtrToStructure(new IntPtr(result.MarkerCorners.ToInt64() + (i * 4 + j) * Marshal.SizeOf(typeof(Point2f))), typeof(Point2f));
+			}
+
+			return true;
+		}
+	}
+}
@@ -0,0 +1,117 @@
+﻿using System;
+
+namespace OpenCvSharp {
+
+	/// <summary>
+	/// Native landmarks stabilizer, replaces the managed PointsDataStabilizer. Takes the flat landmarks buffer filled by
+	/// ShapePredictor.DetectLandmarks (batch overload) and stabilizes all points of all faces within a single call,
+	/// keeping state per face id
+	/// </summary>
+	public class LandmarkStabilizer : DisposableCvObject {
+
+		/// <summary>
+		/// Separate flag from the superclass as we might have our own branch of de-initialization
+		/// </summary>
+		private bool disposed;
+
+		/// <summary>
+		/// Creates stabilizer in one-euro mode
+		/// </summary>
+		public LandmarkStabilizer()
+			: base()
+		{
+			ptr = NativeMethods.utils_LandmarkStabilizer_new();
+		}
+
+		/// <summary>
+		/// Releases the resources
+		/// </summary>
+		/// <param name="disposing">
+		/// If disposing equals true, the method has been called directly or indirectly by a user's code. Managed and unmanaged resources can be disposed.
+		/// If false, the method has been called by the runtime from inside the finalizer and you should not reference other objects. Only unmanaged resources can be disposed.
+		/// </param>
+		protected override void Dispose(bool disposing)
+		{
+			if (!disposed)
+			{
+				try
+				{
+					if (IsEnabledDispose)
+						NativeMethods.utils_LandmarkStabilizer_delete(ptr);
+					disposed = true;
+				}
+				finally
+				{
+					base.Dispose(disposing);
+				}
+			}
+		}
+
+		/// <summary>
+		/// Switches to one-euro filtering: adaptive low-pass with the cutoff growing with points speed
+		/// </summary>
+		/// <param name="minCutoff">Cutoff frequency at rest, Hz: lower is smoother</param>
+		/// <param name="beta">Cutoff growth with the speed: higher is less lag on fast motion</param>
+		/// <param name="derivativeCutoff">Cutoff frequency of the speed estimation, Hz</param>
+		public void SetOneEuro(float minCutoff = 1.0f, float beta = 0.05f, float derivativeCutoff = 1.0f)
+		{
+			ThrowIfDisposed();
+			NativeMethods.utils_LandmarkStabilizer_setOneEuro(ptr, minCutoff, beta, derivativeCutoff);
+		}
+
+		/// <summary>
+		/// Switches to threshold filtering, same as PointsDataStabilizer: the average of the last samplesCount frames
+		/// replaces the output once it moves away further than threshold
+		/// </summary>
+		/// <param name="threshold">Distance in pixels</param>
+		/// <param name="samplesCount">Frames averaged</param>
+		/// <param name="perPoint">Whether points are updated one by one when the mean distance is below the threshold</param>
+		public void SetThreshold(float threshold = 1.0f, int samplesCount = 10, bool perPoint = true)
+		{
+			ThrowIfDisposed();
+			NativeMethods.utils_LandmarkStabilizer_setThreshold(ptr, threshold, samplesCount, perPoint ? 1 : 0);
+		}
+
+		/// <summary>
+		/// Face state is kept for that many Process calls it's missing in
+		/// </summary>
+		public void SetMaxMissedFrames(int value)
+		{
+			ThrowIfDisposed();
+			NativeMethods.utils_LandmarkStabilizer_setMaxMissedFrames(ptr, value);
+		}
+
+		/// <summary>
+		/// Stabilizes landmarks of all faces
+		/// </summary>
+		/// <param name="points">(x, y) pairs, pointsPerFace points face after face</param>
+		/// <param name="facesCount">Number of faces in points</param>
+		/// <param name="faceIds">Faces ids to keep state by, null to use faces indices</param>
+		/// <param name="pointsPerFace">Points per face, ShapePredictor.NumParts</param>
+		/// <param name="dt">Seconds passed since the previous call</param>
+		/// <param name="output">Receives stabilized (x, y) pairs, facesCount * pointsPerFace * 2 values</param>
+		public void Process(int[] points, int facesCount, int[] faceIds, int pointsPerFace, float dt, float[] output)
+		{
+			ThrowIfDisposed();
+			int values = facesCount * pointsPerFace * 2;
+			if (null == points || points.Length < values)
+				throw new ArgumentException("points must contain facesCount * pointsPerFace * 2 values");
+			if (null != faceIds && faceIds.Length < facesCount)
+				throw new ArgumentException("faceIds must contain at least facesCount items");
+			if (null == output || output.Length < values)
+				throw new ArgumentException("output must fit facesCount * pointsPerFace * 2 values");
+
+			if (NativeMethods.utils_LandmarkStabilizer_process(ptr, points, facesCount, faceIds, pointsPerFace, dt, output) < 0)
+				throw new ArgumentException("facesCount and pointsPerFace must not be negative");
+		}
+
+		/// <summary>
+		/// Forgets all faces
+		/// </summary>
+		public void Reset()
+		{
+			ThrowIfDisposed();
+			NativeMethods.utils_LandmarkStabilizer_reset(ptr);
+		}
+	}
+}
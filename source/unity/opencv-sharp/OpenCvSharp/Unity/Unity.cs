@@ -28,17 +28,85 @@ namespace OpenCvSharp {
 		/// <returns>Raw cv::Mat pointer thta holds image formatted for Unity</returns>
 		[DllImport(NativeMethods.DllExtern, CallingConvention = CallingConvention.Cdecl)]
 		private static extern IntPtr utils_mat_to_texture_2(IntPtr mat);
-		
+
+		/// <summary>
+		/// Converts pixel buffer into existing OpenCV Mat, Mat memory is re-used whenever possible
+		/// </summary>
+		/// <param name="pixels32">Source buffer, 32-bit RGBA image is expected</param>
+		/// <param name="w">Source width</param>
+		/// <param name="h">Source height</param>
+		/// <param name="flipVetically">True to flip vertically</param>
+		/// <param name="flipHorizontally">True to flip horizontally</param>
+		/// <param name="rotationAngle">Rotation angle, must be exactly in { 0, 90, 180, 270 } set</param>
+		/// <param name="output">Output cv::Mat pointer</param>
+		/// <returns>1 if output had to be re-allocated, 0 otherwise, -1 if arguments are invalid</returns>
+		[DllImport(NativeMethods.DllExtern, CallingConvention = CallingConvention.Cdecl)]
+		private static extern int utils_texture_to_mat_into(IntPtr pixels32, int w, int h, [MarshalAs(UnmanagedType.I1)] bool flipVetically, [MarshalAs(UnmanagedType.I1)] bool flipHorizontally, int rotationAngle, IntPtr output);
+
+		/// <summary>
+		/// Converts cv::Mat into existing Mat formatted for Unity
+		/// </summary>
+		/// <param name="mat">Raw cv::Mat pointer</param>
+		/// <param name="output">Output cv::Mat pointer</param>
+		/// <returns>1 if output had to be re-allocated, 0 otherwise, -1 if arguments are invalid</returns>
+		[DllImport(NativeMethods.DllExtern, CallingConvention = CallingConvention.Cdecl)]
+		private static extern int utils_mat_to_texture_into_2(IntPtr mat, IntPtr output);
+
+		/// <summary>
+		/// Converts cv::Mat right into the pixels buffer
+		/// </summary>
+		/// <param name="mat">Raw cv::Mat pointer</param>
+		/// <param name="pixels32">Output buffer, 32-bit RGBA</param>
+		/// <param name="w">Output buffer width</param>
+		/// <param name="h">Output buffer height</param>
+		/// <param name="downscale">Downscale factor, must be exactly in { 1, 2, 4 } set</param>
+		/// <returns>1 if buffer has been filled, 0 if it does not match the image or the image can't be converted</returns>
+		[DllImport(NativeMethods.DllExtern, CallingConvention = CallingConvention.Cdecl)]
+		private static extern int utils_mat_to_pixels32_4(IntPtr mat, IntPtr pixels32, int w, int h, int downscale);
+
+		[DllImport(NativeMethods.DllExtern, CallingConvention = CallingConvention.Cdecl)]
+		private static extern int utils_yuv_gray_view(IntPtr yPlane, int yStride, int w, int h, IntPtr output);
+
+		[DllImport(NativeMethods.DllExtern, CallingConvention = CallingConvention.Cdecl)]
+		private static extern int utils_yuv_to_mat_into(IntPtr yPlane, int yStride, IntPtr uPlane, IntPtr vPlane, int uvStride, int uvPixelStride,
+			int w, int h, [MarshalAs(UnmanagedType.I1)] bool flipVetically, [MarshalAs(UnmanagedType.I1)] bool flipHorizontally, int rotationAngle,
+			[MarshalAs(UnmanagedType.I1)] bool grayscale, IntPtr output);
+
+		[DllImport(NativeMethods.DllExtern, CallingConvention = CallingConvention.Cdecl)]
+		private static extern void utils_setMinStripeHeight(int rows);
+
+		[DllImport(NativeMethods.DllExtern, CallingConvention = CallingConvention.Cdecl)]
+		private static extern int utils_getMinStripeHeight();
+
+		/// <summary>
+		/// Minimal stripe height (in output rows) for the parallel texture conversion. Conversion is split into row stripes
+		/// processed on the OpenCV thread pool, threads count is controlled by Cv2.SetNumThreads
+		/// </summary>
+		public static int ConversionMinStripeHeight
+		{
+			get { return utils_getMinStripeHeight(); }
+			set { utils_setMinStripeHeight(value); }
+		}
+
 		/// <summary>
-		/// Data struct to hold raw image data
+		/// Packed YUV 4:2:0 camera frame layouts
 		/// </summary>
-		[StructLayout(LayoutKind.Explicit)]
-		private struct Color32Bytes
+		public enum YuvFormat
 		{
-			[FieldOffset(0)]
-			public byte[] byteArray;
-			[FieldOffset(0)]
-			public Color32[] colors;
+			/// <summary>
+			/// Y plane followed by interleaved U/V plane (iOS bi-planar frames)
+			/// </summary>
+			NV12,
+
+			/// <summary>
+			/// Y plane followed by interleaved V/U plane (Android camera preview default)
+			/// </summary>
+			NV21,
+
+			/// <summary>
+			/// Y plane followed by U plane and V plane, a.k.a. YUV420p
+			/// </summary>
+			I420
 		}
 
 		/// <summary>
@@ -132,7 +200,169 @@ namespace OpenCvSharp {
 			gcHandle.Free ();
 			return mat;
 		}
+
+		/// <summary>
+		/// Converts Unity Texture2D to existing OpenCV Mat, Mat memory is re-used whenever possible
+		/// </summary>
+		/// <returns>True if output Mat had to be re-allocated</returns>
+		/// <param name="texture">Unity texture</param>
+		/// <param name="output">Output mat, keep the same one for the whole session to avoid per-frame allocations</param>
+		/// <param name="parameters">Conversion parameters</param>
+		public static bool TextureToMat(Texture2D texture, Mat output, TextureConversionParams parameters = null)
+		{
+			if (null == parameters)
+				parameters = TextureConversionParams.Default;
+
+			Color32[] pixels32 = texture.GetPixels32();
+			return PixelsToMat(pixels32, texture.width, texture.height, parameters.FlipVertically, parameters.FlipHorizontally, parameters.RotationAngle, output);
+		}
+
+		/// <summary>
+		/// Converts Unity WebCamTexture to existing OpenCV Mat, Mat memory is re-used whenever possible
+		/// </summary>
+		/// <returns>True if output Mat had to be re-allocated</returns>
+		/// <param name="texture">Unity texture</param>
+		/// <param name="output">Output mat, keep the same one for the whole session to avoid per-frame allocations</param>
+		/// <param name="parameters">Conversion parameters</param>
+		/// <param name="pixels32">Optional pixels buffer to read texture into, avoids managed allocation if it matches texture size</param>
+		public static bool TextureToMat(WebCamTexture texture, Mat output, TextureConversionParams parameters = null, Color32[] pixels32 = null)
+		{
+			if (null == parameters)
+				parameters = TextureConversionParams.Default;
+
+			if (null == pixels32 || pixels32.Length != texture.width * texture.height)
+				pixels32 = texture.GetPixels32();
+			else
+				texture.GetPixels32(pixels32);
+			return PixelsToMat(pixels32, texture.width, texture.height, parameters.FlipVertically, parameters.FlipHorizontally, parameters.RotationAngle, output);
+		}
+
+		/// <summary>
+		/// Converts Unity pixels buffer to existing OpenCV Mat, Mat memory is re-used whenever possible
+		/// </summary>
+		/// <param name="pixels32">Source buffer with RGBA texture (8 bits per channel, 32 bits total)</param>
+		/// <param name="width">Input buffer width</param>
+		/// <param name="height">Input buffer height</param>
+		/// <param name="flipVetically">True if OpenCV image should flip source vertically </param>
+		/// <param name="flipHorizontally">True if OpenCV image should flip source horizontally</param>
+		/// <param name="rotationAngle">Source buffer rotation angle (for camera-sourced images), must be in { 0, 90, 180, 270 } set</param>
+		/// <param name="output">Output mat, receives image in OpenCV format</param>
+		/// <returns>True if output Mat had to be re-allocated</returns>
+		public static bool PixelsToMat(Color32[] pixels32, int width, int height, bool flipVertically, bool flipHorizontally, int rotationAngle, Mat output)
+		{
+			// make sure angle is defined correctly
+			if (0 != rotationAngle && 90 != rotationAngle && 180 != rotationAngle && 270 != rotationAngle)
+				throw new ArgumentException(string.Format("OpenCvSharp.PixelsToMat: rotationAngle argument = {0}, is not in ( 0, 90, 180, 270 ) set", rotationAngle));
+			if (null == pixels32)
+				throw new ArgumentNullException("pixels32");
+			if (null == output)
+				throw new ArgumentNullException("output");
+			output.ThrowIfDisposed();
+
+			GCHandle gcHandle = GCHandle.Alloc(pixels32, GCHandleType.Pinned);
+
+			// see PixelsToMat above regarding negated flipVertically
+			int reallocated = utils_texture_to_mat_into(gcHandle.AddrOfPinnedObject(), width, height, !flipVertically, flipHorizontally, rotationAngle, output.CvPtr);
+			gcHandle.Free();
+			if (reallocated < 0)
+				throw new OpenCvSharpException(string.Format("OpenCvSharp.PixelsToMat: failed to convert {0}x{1} pixels buffer", width, height));
+			return reallocated != 0;
+		}
 		
+		/// <summary>
+		/// Converts packed YUV 4:2:0 camera frame to existing OpenCV Mat, colour conversion, rotation and flips are done in one pass
+		/// </summary>
+		/// <param name="frame">Frame data, Y plane is followed by chroma plane(s) without any padding</param>
+		/// <param name="format">Frame layout</param>
+		/// <param name="width">Frame width</param>
+		/// <param name="height">Frame height</param>
+		/// <param name="parameters">Conversion parameters, unlike Unity textures camera frames are stored top-down, so no implicit vertical flip is applied</param>
+		/// <param name="output">Output mat, receives BGR or grayscale image</param>
+		/// <param name="grayscale">True to produce 1-channel grayscale image (chroma is not touched at all), false for 3-channel BGR</param>
+		/// <returns>True if output Mat had to be re-allocated</returns>
+		public static bool YuvToMat(byte[] frame, YuvFormat format, int width, int height, TextureConversionParams parameters, Mat output, bool grayscale = false)
+		{
+			if (null == frame)
+				throw new ArgumentNullException("frame");
+			if (frame.Length < width * height * 3 / 2)
+				throw new ArgumentException(string.Format("OpenCvSharp.YuvToMat: frame length = {0}, is too small for {1}x{2} YUV 4:2:0 frame", frame.Length, width, height));
+
+			GCHandle gcHandle = GCHandle.Alloc(frame, GCHandleType.Pinned);
+			try
+			{
+				IntPtr y = gcHandle.AddrOfPinnedObject();
+				IntPtr chroma = new IntPtr(y.ToInt64() + width * height);
+				switch (format)
+				{
+					case YuvFormat.NV12:
+						return YuvToMat(y, width, chroma, new IntPtr(chroma.ToInt64() + 1), width, 2, width, height, parameters, output, grayscale);
+					case YuvFormat.NV21:
+						return YuvToMat(y, width, new IntPtr(chroma.ToInt64() + 1), chroma, width, 2, width, height, parameters, output, grayscale);
+					case YuvFormat.I420:
+						return YuvToMat(y, width, chroma, new IntPtr(chroma.ToInt64() + (width / 2) * (height / 2)), width / 2, 1, width, height, parameters, output, grayscale);
+					default:
+						throw new ArgumentOutOfRangeException("format", format, null);
+				}
+			}
+			finally
+			{
+				gcHandle.Free();
+			}
+		}
+
+		/// <summary>
+		/// Converts YUV 4:2:0 camera frame given as separate planes (for example, Android YUV_420_888 image) to existing OpenCV Mat,
+		/// colour conversion, rotation and flips are done in one pass
+		/// </summary>
+		/// <param name="yPlane">Luma plane</param>
+		/// <param name="yStride">Luma row stride, bytes</param>
+		/// <param name="uPlane">First U sample</param>
+		/// <param name="vPlane">First V sample</param>
+		/// <param name="uvStride">Chroma row stride, bytes</param>
+		/// <param name="uvPixelStride">Distance between two chroma samples in a row: 2 for interleaved chroma, 1 for planar</param>
+		/// <param name="width">Frame width</param>
+		/// <param name="height">Frame height</param>
+		/// <param name="parameters">Conversion parameters, no implicit vertical flip is applied</param>
+		/// <param name="output">Output mat, receives BGR or grayscale image</param>
+		/// <param name="grayscale">True to produce 1-channel grayscale image (chroma planes might be IntPtr.Zero), false for 3-channel BGR</param>
+		/// <returns>True if output Mat had to be re-allocated</returns>
+		public static bool YuvToMat(IntPtr yPlane, int yStride, IntPtr uPlane, IntPtr vPlane, int uvStride, int uvPixelStride, int width, int height,
+			TextureConversionParams parameters, Mat output, bool grayscale = false)
+		{
+			if (null == parameters)
+				parameters = TextureConversionParams.Default;
+			if (0 != parameters.RotationAngle && 90 != parameters.RotationAngle && 180 != parameters.RotationAngle && 270 != parameters.RotationAngle)
+				throw new ArgumentException(string.Format("OpenCvSharp.YuvToMat: rotationAngle = {0}, is not in ( 0, 90, 180, 270 ) set", parameters.RotationAngle));
+			if (null == output)
+				throw new ArgumentNullException("output");
+			output.ThrowIfDisposed();
+
+			int reallocated = utils_yuv_to_mat_into(yPlane, yStride, uPlane, vPlane, uvStride, uvPixelStride, width, height,
+				parameters.FlipVertically, parameters.FlipHorizontally, parameters.RotationAngle, grayscale, output.CvPtr);
+			if (reallocated < 0)
+				throw new OpenCvSharpException(string.Format("OpenCvSharp.YuvToMat: failed to convert {0}x{1} frame, planes or strides are invalid", width, height));
+			return reallocated != 0;
+		}
+
+		/// <summary>
+		/// Makes output Mat a grayscale view over the luma plane of the YUV frame, no pixel data is copied, that is
+		/// enough for cascade or ArUco detection. The Mat is valid only while the frame memory is alive (pinned)
+		/// </summary>
+		/// <param name="yPlane">Luma plane</param>
+		/// <param name="yStride">Luma row stride, bytes</param>
+		/// <param name="width">Frame width</param>
+		/// <param name="height">Frame height</param>
+		/// <param name="output">Output mat</param>
+		public static void YuvToGrayView(IntPtr yPlane, int yStride, int width, int height, Mat output)
+		{
+			if (null == output)
+				throw new ArgumentNullException("output");
+			output.ThrowIfDisposed();
+
+			if (utils_yuv_gray_view(yPlane, yStride, width, height, output.CvPtr) < 0)
+				throw new OpenCvSharpException(string.Format("OpenCvSharp.YuvToGrayView: invalid {0}x{1} frame with {2} bytes stride", width, height, yStride));
+		}
+
 		/// <summary>
 		/// Converts OpenCV Mat to Unity texture
 		/// </summary>
@@ -140,23 +370,82 @@ namespace OpenCvSharp {
 		/// <param name="mat">OpenCV Mat</param>
 		/// <param name="outTexture">Unity texture to set pixels</param>
 		public static Texture2D MatToTexture(Mat mat, Texture2D outTexture = null)
+		{
+			return MatToTexture(mat, outTexture, null);
+		}
+
+		/// <summary>
+		/// Converts OpenCV Mat to Unity texture
+		/// </summary>
+		/// <returns>Unity texture</returns>
+		/// <param name="mat">OpenCV Mat</param>
+		/// <param name="outTexture">Unity texture to set pixels</param>
+		/// <param name="pixels32">Pixels buffer to convert Mat into, re-used if matches texture size</param>
+		/// <param name="downscale">Downscale factor, must be in { 1, 2, 4 } set, texture size is Mat size divided by this value</param>
+		public static Texture2D MatToTexture(Mat mat, Texture2D outTexture, Color32[] pixels32, int downscale = 1)
 		{
 			Size size = mat.Size();
-			using (Mat unityMat = new Mat(utils_mat_to_texture_2(mat.CvPtr)))
-			{
-				if (null == outTexture || outTexture.width != size.Width || outTexture.height != size.Height)
-					outTexture = new Texture2D(size.Width, size.Height);
-
-				int count = size.Width * size.Height;
-				Color32Bytes data = new Color32Bytes();
-				data.byteArray = new byte[count * 4];
-				data.colors = new Color32[count];
-				Marshal.Copy(unityMat.Data, data.byteArray, 0, data.byteArray.Length);
-				outTexture.SetPixels32(data.colors);
-				outTexture.Apply();
-
-				return outTexture;
-			}
+			size.Width /= Math.Max(1, downscale);
+			size.Height /= Math.Max(1, downscale);
+			if (null == outTexture || outTexture.width != size.Width || outTexture.height != size.Height)
+				outTexture = new Texture2D(size.Width, size.Height);
+
+			if (null == pixels32 || pixels32.Length != size.Width * size.Height)
+				pixels32 = new Color32[size.Width * size.Height];
+
+			MatToPixels(mat, pixels32, downscale);
+			outTexture.SetPixels32(pixels32);
+			outTexture.Apply();
+
+			return outTexture;
+		}
+
+		/// <summary>
+		/// Converts OpenCV Mat right into Unity pixels buffer, optionally downscaling it (flip, color conversion and downscale are done in one pass)
+		/// </summary>
+		/// <param name="mat">OpenCV Mat</param>
+		/// <param name="pixels32">Output buffer, must have exactly (mat.Width / downscale) * (mat.Height / downscale) elements</param>
+		/// <param name="downscale">Downscale factor, must be in { 1, 2, 4 } set, downscaled image is box-filtered</param>
+		public static void MatToPixels(Mat mat, Color32[] pixels32, int downscale = 1)
+		{
+			if (null == mat)
+				throw new ArgumentNullException("mat");
+			if (null == pixels32)
+				throw new ArgumentNullException("pixels32");
+			if (1 != downscale && 2 != downscale && 4 != downscale)
+				throw new ArgumentException(string.Format("OpenCvSharp.MatToPixels: downscale argument = {0}, is not in ( 1, 2, 4 ) set", downscale));
+			mat.ThrowIfDisposed();
+
+			int width = mat.Width / downscale, height = mat.Height / downscale;
+			if (pixels32.Length != width * height)
+				throw new ArgumentException(string.Format("OpenCvSharp.MatToPixels: pixels32 length = {0}, does not match output size {1}x{2}", pixels32.Length, width, height));
+
+			GCHandle gcHandle = GCHandle.Alloc(pixels32, GCHandleType.Pinned);
+			int written = utils_mat_to_pixels32_4(mat.CvPtr, gcHandle.AddrOfPinnedObject(), width, height, downscale);
+			gcHandle.Free();
+			if (0 == written)
+				throw new OpenCvSharpException(string.Format("OpenCvSharp.MatToPixels: failed to convert mat, 8-bit 1, 3 or 4-channel image is expected, got {0}", mat.Type()));
+		}
+
+		/// <summary>
+		/// Converts OpenCV Mat to existing Mat with Unity-formatted (RGBA, flipped) data, suitable for Texture2D.LoadRawTextureData
+		/// </summary>
+		/// <returns>True if output Mat had to be re-allocated</returns>
+		/// <param name="mat">OpenCV Mat</param>
+		/// <param name="output">Output mat, keep the same one for the whole session to avoid per-frame allocations</param>
+		public static bool MatToTextureMat(Mat mat, Mat output)
+		{
+			if (null == mat)
+				throw new ArgumentNullException("mat");
+			if (null == output)
+				throw new ArgumentNullException("output");
+			mat.ThrowIfDisposed();
+			output.ThrowIfDisposed();
+
+			int reallocated = utils_mat_to_texture_into_2(mat.CvPtr, output.CvPtr);
+			if (reallocated < 0)
+				throw new OpenCvSharpException("OpenCvSharp.MatToTextureMat: failed to convert mat");
+			return reallocated != 0;
 		}
 
 
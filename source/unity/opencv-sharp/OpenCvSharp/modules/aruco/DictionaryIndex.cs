@@ -0,0 +1,118 @@
+﻿using System;
+
+namespace OpenCvSharp.Aruco
+{
+    /// <summary>
+    /// Bit-packed dictionary codes index: exact matches are found by hash lookup, error-correcting ones by popcount
+    /// Hamming distance over 64-bit codes. Results are the same as Dictionary identification done by DetectMarkers
+    /// </summary>
+    public class DictionaryIndex : DisposableCvObject
+    {
+        /// <summary>
+        /// Track whether Dispose has been called
+        /// </summary>
+        private bool disposed;
+
+        #region Init and Disposal
+
+        /// <summary>
+        /// Builds index over the dictionary codes
+        /// </summary>
+        public DictionaryIndex(Dictionary dictionary)
+        {
+            if (dictionary == null)
+                throw new ArgumentNullException("dictionary");
+
+            ptr = NativeMethods.aruco_DictionaryIndex_new(dictionary.ptrObj.CvPtr);
+            GC.KeepAlive(dictionary);
+        }
+
+        /// <summary>
+        /// Clean up any resources being used.
+        /// </summary>
+        /// <param name="disposing">
+        /// If disposing equals true, the method has been called directly or indirectly by a user's code. Managed and unmanaged resources can be disposed.
+        /// If false, the method has been called by the runtime from inside the finalizer and you should not reference other objects. Only unmanaged resources can be disposed.
+        /// </param>
+        protected override void Dispose(bool disposing)
+        {
+            if (!disposed)
+            {
+                try
+                {
+                    if (IsEnabledDispose)
+                    {
+                        NativeMethods.aruco_DictionaryIndex_delete(ptr);
+                    }
+                    disposed = true;
+                }
+                finally
+                {
+                    base.Dispose(disposing);
+                }
+            }
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Number of markers
+        /// </summary>
+        public int Size
+        {
+            get
+            {
+                ThrowIfDisposed();
+                return NativeMethods.aruco_DictionaryIndex_size(ptr);
+            }
+        }
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Identifies marker bits
+        /// </summary>
+        /// <param name="onlyBits">markerSize x markerSize CV_8UC1 matrix of 0/1 bits, without the border</param>
+        /// <param name="maxCorrectionRate">part of the dictionary MaxCorrectionBits allowed to be erroneous</param>
+        /// <param name="idx">marker id</param>
+        /// <param name="rotation">marker rotation</param>
+        /// <returns>True if bits match one of the markers</returns>
+        public bool Identify(Mat onlyBits, double maxCorrectionRate, out int idx, out int rotation)
+        {
+            ThrowIfDisposed();
+            if (onlyBits == null)
+                throw new ArgumentNullException("onlyBits");
+
+            bool ret = NativeMethods.aruco_DictionaryIndex_identify(ptr, onlyBits.CvPtr, maxCorrectionRate, out idx, out rotation) != 0;
+            GC.KeepAlive(onlyBits);
+            return ret;
+        }
+
+        /// <summary>
+        /// Identifies a batch of packed codes, bit k of the code is the marker bit at row k / markerSize, column k % markerSize
+        /// </summary>
+        /// <param name="codes">packed codes</param>
+        /// <param name="maxCorrectionRate">part of the dictionary MaxCorrectionBits allowed to be erroneous</param>
+        /// <param name="ids">receives marker ids, -1 for codes not identified, must fit codes.Length values</param>
+        /// <param name="rotations">optional, receives markers rotations</param>
+        /// <returns>Number of identified codes</returns>
+        public int IdentifyBatch(ulong[] codes, double maxCorrectionRate, int[] ids, int[] rotations = null)
+        {
+            ThrowIfDisposed();
+            if (codes == null)
+                throw new ArgumentNullException("codes");
+            if (ids == null || ids.Length < codes.Length)
+                throw new ArgumentException("ids must contain at least codes.Length items");
+            if (rotations != null && rotations.Length < codes.Length)
+                throw new ArgumentException("rotations must contain at least codes.Length items");
+
+            return NativeMethods.aruco_DictionaryIndex_identifyBatch(ptr, codes, codes.Length, maxCorrectionRate, ids, rotations);
+        }
+
+        #endregion
+    }
+}
@@ -0,0 +1,169 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+using OpenCvSharp.Util;
+
+namespace OpenCvSharp.Aruco
+{
+    /// <summary>
+    /// Single marker pose, native aruco_MarkerPose layout
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct MarkerPose
+    {
+        /// <summary>
+        /// Marker id
+        /// </summary>
+        public int Id;
+
+        /// <summary>
+        /// Smoothed rotation (Rodrigues) vector
+        /// </summary>
+        public Vec3d Rvec;
+
+        /// <summary>
+        /// Smoothed translation, marker length units
+        /// </summary>
+        public Vec3d Tvec;
+
+        /// <summary>
+        /// RMS reprojection error of the raw (not smoothed) pose, pixels
+        /// </summary>
+        public double ReprojError;
+    }
+
+    /// <summary>
+    /// Markers detection, pose estimation and temporal smoothing in a single native call.
+    /// Detection is done by MarkerTracker, pose estimation is warm-started from the marker previous pose
+    /// </summary>
+    public class MarkerPoseTracker : DisposableCvObject
+    {
+        /// <summary>
+        /// Track whether Dispose has been called
+        /// </summary>
+        private bool disposed;
+
+        #region Init and Disposal
+
+        /// <summary>
+        /// Creates tracker
+        /// </summary>
+        /// <param name="dictionary">indicates the type of markers that will be searched</param>
+        /// <param name="markerLength">marker side length, poses translation is in the same units</param>
+        /// <param name="cameraMatrix">input 3x3 floating-point camera matrix</param>
+        /// <param name="distCoeffs">vector of distortion coefficients of 4, 5, 8 or 12 elements, might be null</param>
+        /// <param name="parameters">marker detection parameters, copied, null for defaults</param>
+        public MarkerPoseTracker(Dictionary dictionary, float markerLength, double[,] cameraMatrix, IEnumerable<double> distCoeffs, DetectorParameters parameters = null)
+        {
+            if (dictionary == null)
+                throw new ArgumentNullException("dictionary");
+            if (cameraMatrix == null)
+                throw new ArgumentNullException("cameraMatrix");
+            if (cameraMatrix.GetLength(0) != 3 || cameraMatrix.GetLength(1) != 3)
+                throw new ArgumentException("cameraMatrix must be 3x3");
+
+            double[] cameraMatrixArray = new double[9];
+            for (int i = 0; i < 3; ++i)
+                for (int j = 0; j < 3; ++j)
+                    cameraMatrixArray[i * 3 + j] = cameraMatrix[i, j];
+
+            double[] distCoeffsArray = (distCoeffs == null) ? null : EnumerableEx.ToArray(distCoeffs);
+            int distCoeffsLength = (distCoeffsArray == null) ? 0 : distCoeffsArray.Length;
+
+            ptr = NativeMethods.aruco_MarkerPoseTracker_new(dictionary.ptrObj.CvPtr, (parameters != null) ? parameters.ptrObj.CvPtr : IntPtr.Zero,
+                markerLength, cameraMatrixArray, distCoeffsArray, distCoeffsLength);
+            GC.KeepAlive(dictionary);
+            GC.KeepAlive(parameters);
+        }
+
+        /// <summary>
+        /// Clean up any resources being used.
+        /// </summary>
+        /// <param name="disposing">
+        /// If disposing equals true, the method has been called directly or indirectly by a user's code. Managed and unmanaged resources can be disposed.
+        /// If false, the method has been called by the runtime from inside the finalizer and you should not reference other objects. Only unmanaged resources can be disposed.
+        /// </param>
+        protected override void Dispose(bool disposing)
+        {
+            if (!disposed)
+            {
+                try
+                {
+                    if (IsEnabledDispose)
+                    {
+                        NativeMethods.aruco_MarkerPoseTracker_delete(ptr);
+                    }
+                    disposed = true;
+                }
+                finally
+                {
+                    base.Dispose(disposing);
+                }
+            }
+        }
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Replaces detection parameters with a copy of the given ones, null for defaults
+        /// </summary>
+        public void SetParameters(DetectorParameters parameters)
+        {
+            ThrowIfDisposed();
+            NativeMethods.aruco_MarkerPoseTracker_setParameters(ptr, (parameters != null) ? parameters.ptrObj.CvPtr : IntPtr.Zero);
+            GC.KeepAlive(parameters);
+        }
+
+        /// <summary>
+        /// Sets detection parameters, see MarkerTracker.SetTrackingParams and MarkerTracker.PyramidScale
+        /// </summary>
+        public void SetTrackingParams(int rescanInterval = 15, double roiPadding = 0.5, double pyramidScale = 1.0)
+        {
+            ThrowIfDisposed();
+            NativeMethods.aruco_MarkerPoseTracker_setTrackingParams(ptr, rescanInterval, roiPadding, pyramidScale);
+        }
+
+        /// <summary>
+        /// Sets temporal smoothing parameters
+        /// </summary>
+        /// <param name="smoothing">weight of the previous pose, [0, 1), 0 to get raw poses</param>
+        /// <param name="maxMissedFrames">marker previous pose is kept for that many frames it's missing</param>
+        public void SetSmoothing(double smoothing = 0.5, int maxMissedFrames = 5)
+        {
+            ThrowIfDisposed();
+            NativeMethods.aruco_MarkerPoseTracker_setSmoothing(ptr, smoothing, maxMissedFrames);
+        }
+
+        /// <summary>
+        /// Detects markers and writes their poses into the pre-allocated buffer
+        /// </summary>
+        /// <param name="image">8-bit grayscale or BGR image</param>
+        /// <param name="output">poses buffer</param>
+        /// <returns>Number of markers detected, only the first output.Length of them are written</returns>
+        public int Process(Mat image, MarkerPose[] output)
+        {
+            ThrowIfDisposed();
+            if (image == null)
+                throw new ArgumentNullException("image");
+            if (output == null)
+                throw new ArgumentNullException("output");
+
+            int count = NativeMethods.aruco_MarkerPoseTracker_process(ptr, image.CvPtr, output, output.Length);
+            GC.KeepAlive(image);
+            return count;
+        }
+
+        /// <summary>
+        /// Forgets detected markers and their poses
+        /// </summary>
+        public void Reset()
+        {
+            ThrowIfDisposed();
+            NativeMethods.aruco_MarkerPoseTracker_reset(ptr);
+        }
+
+        #endregion
+    }
+}
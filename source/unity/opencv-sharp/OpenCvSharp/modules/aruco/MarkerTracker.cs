@@ -0,0 +1,147 @@
+﻿using System;
+
+namespace OpenCvSharp.Aruco
+{
+    /// <summary>
+    /// Stateful markers detector: searches markers around their previous frame positions only,
+    /// the full frame is scanned every RescanInterval frames or once any of the tracked markers is lost
+    /// </summary>
+    public class MarkerTracker : DisposableCvObject
+    {
+        /// <summary>
+        /// Track whether Dispose has been called
+        /// </summary>
+        private bool disposed;
+
+        #region Init and Disposal
+
+        /// <summary>
+        /// Creates tracker
+        /// </summary>
+        /// <param name="dictionary">indicates the type of markers that will be searched</param>
+        /// <param name="parameters">marker detection parameters, copied, null for defaults</param>
+        public MarkerTracker(Dictionary dictionary, DetectorParameters parameters = null)
+        {
+            if (dictionary == null)
+                throw new ArgumentNullException("dictionary");
+
+            ptr = NativeMethods.aruco_MarkerTracker_new(dictionary.ptrObj.CvPtr, (parameters != null) ? parameters.ptrObj.CvPtr : IntPtr.Zero);
+            GC.KeepAlive(dictionary);
+            GC.KeepAlive(parameters);
+        }
+
+        /// <summary>
+        /// Clean up any resources being used.
+        /// </summary>
+        /// <param name="disposing">
+        /// If disposing equals true, the method has been called directly or indirectly by a user's code. Managed and unmanaged resources can be disposed.
+        /// If false, the method has been called by the runtime from inside the finalizer and you should not reference other objects. Only unmanaged resources can be disposed.
+        /// </param>
+        protected override void Dispose(bool disposing)
+        {
+            if (!disposed)
+            {
+                try
+                {
+                    if (IsEnabledDispose)
+                    {
+                        NativeMethods.aruco_MarkerTracker_delete(ptr);
+                    }
+                    disposed = true;
+                }
+                finally
+                {
+                    base.Dispose(disposing);
+                }
+            }
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Coarse-to-fine full scans for high resolution frames: markers candidates are searched on the frame downscaled
+        /// by this factor, corners and bits are extracted at full resolution around the candidates only.
+        /// 1 (default) detects at full resolution, 0 picks the factor from MinMarkerPerimeterRate
+        /// </summary>
+        public double PyramidScale
+        {
+            get
+            {
+                ThrowIfDisposed();
+                return NativeMethods.aruco_MarkerTracker_getPyramidScale(ptr);
+            }
+            set
+            {
+                ThrowIfDisposed();
+                NativeMethods.aruco_MarkerTracker_setPyramidScale(ptr, value);
+            }
+        }
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Replaces detection parameters with a copy of the given ones, null for defaults.
+        /// Parameters are copied, call it again after changing them
+        /// </summary>
+        public void SetParameters(DetectorParameters parameters)
+        {
+            ThrowIfDisposed();
+            NativeMethods.aruco_MarkerTracker_setParameters(ptr, (parameters != null) ? parameters.ptrObj.CvPtr : IntPtr.Zero);
+            GC.KeepAlive(parameters);
+        }
+
+        /// <summary>
+        /// Sets tracking parameters
+        /// </summary>
+        /// <param name="rescanInterval">Full frame is scanned every rescanInterval frames, 1 to scan every frame.
+        /// New markers are picked up on full scans only</param>
+        /// <param name="roiPadding">Search area is the previous marker bounding rect padded by roiPadding of its size at every side</param>
+        public void SetTrackingParams(int rescanInterval = 15, double roiPadding = 0.5)
+        {
+            ThrowIfDisposed();
+            NativeMethods.aruco_MarkerTracker_setTrackingParams(ptr, rescanInterval, roiPadding);
+        }
+
+        /// <summary>
+        /// Detects markers using previous frame results, same output as CvAruco.DetectMarkers
+        /// </summary>
+        /// <param name="image">8-bit grayscale or BGR image</param>
+        /// <param name="corners">detected marker corners, four per marker, clockwise</param>
+        /// <param name="ids">identifiers of the detected markers, same order as corners</param>
+        /// <returns>True if the whole frame has been scanned this time, false if only tracked areas</returns>
+        public bool Track(Mat image, out Point2f[][] corners, out int[] ids)
+        {
+            ThrowIfDisposed();
+            if (image == null)
+                throw new ArgumentNullException("image");
+
+            int fullScan;
+            using (var cornersVec = new VectorOfVectorPoint2f())
+            using (var idsVec = new VectorOfInt32())
+            {
+                fullScan = NativeMethods.aruco_MarkerTracker_track(ptr, image.CvPtr, cornersVec.CvPtr, idsVec.CvPtr);
+
+                corners = cornersVec.ToArray();
+                ids = idsVec.ToArray();
+            }
+
+            GC.KeepAlive(image);
+            return fullScan != 0;
+        }
+
+        /// <summary>
+        /// Forgets tracked markers, the next Track call scans the full frame
+        /// </summary>
+        public void Reset()
+        {
+            ThrowIfDisposed();
+            NativeMethods.aruco_MarkerTracker_reset(ptr);
+        }
+
+        #endregion
+    }
+}
@@ -0,0 +1,50 @@
+﻿
+namespace OpenCvSharp
+{
+    /// <summary>
+    /// Native object type tags for the batched release, values must match core_Release.h
+    /// </summary>
+    public enum NativeHandleType : int
+    {
+        /// <summary>
+        /// cv::Mat*
+        /// </summary>
+        Mat = 0,
+
+        /// <summary>
+        /// Any cv::Ptr&lt;T&gt;*, released natively as cv::Ptr&lt;void&gt;*: relies on OpenCV 3.x cv::Ptr layout being
+        /// the same for every T (ownership is type-erased), use the type's own *_Ptr_*_delete otherwise
+        /// </summary>
+        Ptr = 1,
+
+#pragma warning disable 1591
+        VectorUChar = 10,
+        VectorInt32,
+        VectorFloat,
+        VectorDouble,
+        VectorVec2f,
+        VectorVec3f,
+        VectorVec4f,
+        VectorVec4i,
+        VectorVec6f,
+        VectorVec6d,
+        VectorPoint,
+        VectorPoint2f,
+        VectorPoint3f,
+        VectorRect,
+        VectorKeyPoint,
+        VectorDMatch,
+        VectorString,
+        VectorMat,
+
+        VectorVectorInt = 40,
+        VectorVectorFloat,
+        VectorVectorDouble,
+        VectorVectorKeyPoint,
+        VectorVectorDMatch,
+        VectorVectorPoint,
+        VectorVectorPoint2f,
+        VectorVectorVec2i,
+#pragma warning restore 1591
+    }
+}
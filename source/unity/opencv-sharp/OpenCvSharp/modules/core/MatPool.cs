@@ -0,0 +1,110 @@
+﻿using System;
+
+namespace OpenCvSharp
+{
+    /// <summary>
+    /// Native pool of Mat buffers keyed by size and type. When enabled, Mat(rows, cols, type) constructors,
+    /// Clone() and T() draw from it and disposed Mats return their buffers into it, so per-frame images of
+    /// the same geometry don't re-allocate
+    /// </summary>
+    public static class MatPool
+    {
+        /// <summary>
+        /// Pool statistics
+        /// </summary>
+        public struct Statistics
+        {
+            /// <summary>
+            /// Number of requests served from the pool
+            /// </summary>
+            public ulong Hits;
+
+            /// <summary>
+            /// Number of requests that had to allocate
+            /// </summary>
+            public ulong Misses;
+
+            /// <summary>
+            /// Bytes currently held by the pool
+            /// </summary>
+            public ulong BytesHeld;
+
+            /// <summary>
+            /// Number of buffers currently held by the pool
+            /// </summary>
+            public int BuffersHeld;
+        }
+
+        /// <summary>
+        /// Whether regular Mat allocations go through the pool, disabled by default
+        /// </summary>
+        public static bool Enabled
+        {
+            get { return NativeMethods.core_MatPool_getEnabled() != 0; }
+            set { NativeMethods.core_MatPool_setEnabled(value ? 1 : 0); }
+        }
+
+        /// <summary>
+        /// Max bytes the pool may hold, 64 Mb by default
+        /// </summary>
+        public static ulong Capacity
+        {
+            get { return NativeMethods.core_MatPool_getCapacity(); }
+            set { NativeMethods.core_MatPool_setCapacity(value); }
+        }
+
+        /// <summary>
+        /// Current pool statistics
+        /// </summary>
+        public static Statistics Stats
+        {
+            get
+            {
+                Statistics stats;
+                NativeMethods.core_MatPool_getStats(out stats.Hits, out stats.Misses, out stats.BytesHeld, out stats.BuffersHeld);
+                return stats;
+            }
+        }
+
+        /// <summary>
+        /// Takes Mat from the pool regardless of the Enabled flag, contents are undefined
+        /// </summary>
+        public static Mat Acquire(int rows, int cols, MatType type)
+        {
+            return new Mat(NativeMethods.core_MatPool_acquire(rows, cols, type));
+        }
+
+        /// <summary>
+        /// Disposes Mat returning its buffer into the pool regardless of the Enabled flag. Buffer is pooled only if
+        /// nothing else references it (no other Mats/ROIs sharing the data)
+        /// </summary>
+        /// <returns>True if buffer has been pooled</returns>
+        public static bool Release(Mat mat)
+        {
+            if (null == mat)
+                throw new ArgumentNullException("mat");
+            mat.ThrowIfDisposed();
+
+            bool pooled = NativeMethods.core_MatPool_release(mat.CvPtr) != 0;
+            mat.IsEnabledDispose = false;
+            mat.Dispose();
+            return pooled;
+        }
+
+        /// <summary>
+        /// Drops all pooled buffers
+        /// </summary>
+        public static void Clear()
+        {
+            NativeMethods.core_MatPool_clear();
+        }
+
+        /// <summary>
+        /// Resets hits/misses counters
+        /// </summary>
+        public static void ResetStats()
+        {
+            NativeMethods.core_MatPool_resetStats();
+        }
+    }
+}
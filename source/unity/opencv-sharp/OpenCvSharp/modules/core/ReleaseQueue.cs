@@ -0,0 +1,127 @@
+﻿using System;
+using System.Collections.Generic;
+
+namespace OpenCvSharp
+{
+    /// <summary>
+    /// Deferred release queue: objects are detached from their managed wrappers right away and released
+    /// natively in one call when the queue is flushed (typically once per frame), instead of one native
+    /// call per object
+    /// </summary>
+    public class ReleaseQueue
+    {
+        /// <summary>
+        /// Vector wrapper types supported by Enqueue(DisposableCvObject), Mat and its subclasses are handled separately
+        /// </summary>
+        private static readonly Dictionary<Type, NativeHandleType> wrapperTypes = new Dictionary<Type, NativeHandleType>
+        {
+            {typeof (VectorOfByte), NativeHandleType.VectorUChar},
+            {typeof (VectorOfInt32), NativeHandleType.VectorInt32},
+            {typeof (VectorOfFloat), NativeHandleType.VectorFloat},
+            {typeof (VectorOfDouble), NativeHandleType.VectorDouble},
+            {typeof (VectorOfVec2f), NativeHandleType.VectorVec2f},
+            {typeof (VectorOfVec3f), NativeHandleType.VectorVec3f},
+            {typeof (VectorOfVec4f), NativeHandleType.VectorVec4f},
+            {typeof (VectorOfVec4i), NativeHandleType.VectorVec4i},
+            {typeof (VectorOfVec6f), NativeHandleType.VectorVec6f},
+            {typeof (VectorOfVec6d), NativeHandleType.VectorVec6d},
+            {typeof (VectorOfPoint), NativeHandleType.VectorPoint},
+            {typeof (VectorOfPoint2f), NativeHandleType.VectorPoint2f},
+            {typeof (VectorOfPoint3f), NativeHandleType.VectorPoint3f},
+            {typeof (VectorOfRect), NativeHandleType.VectorRect},
+            {typeof (VectorOfKeyPoint), NativeHandleType.VectorKeyPoint},
+            {typeof (VectorOfDMatch), NativeHandleType.VectorDMatch},
+            {typeof (VectorOfString), NativeHandleType.VectorString},
+            {typeof (VectorOfMat), NativeHandleType.VectorMat},
+            {typeof (VectorOfVectorInt), NativeHandleType.VectorVectorInt},
+            {typeof (VectorOfVectorFloat), NativeHandleType.VectorVectorFloat},
+            {typeof (VectorOfVectorDouble), NativeHandleType.VectorVectorDouble},
+            {typeof (VectorOfVectorKeyPoint), NativeHandleType.VectorVectorKeyPoint},
+            {typeof (VectorOfVectorDMatch), NativeHandleType.VectorVectorDMatch},
+            {typeof (VectorOfVectorPoint), NativeHandleType.VectorVectorPoint},
+            {typeof (VectorOfVectorPoint2f), NativeHandleType.VectorVectorPoint2f},
+            {typeof (VectorOfVectorVec2i), NativeHandleType.VectorVectorVec2i},
+        };
+
+        private readonly object sync = new object();
+        private int[] types = new int[64];
+        private IntPtr[] objects = new IntPtr[64];
+        private int count;
+
+        /// <summary>
+        /// Number of objects waiting for release
+        /// </summary>
+        public int Count
+        {
+            get
+            {
+                lock (sync)
+                    return count;
+            }
+        }
+
+        /// <summary>
+        /// Queues raw native object for release, caller must not use or delete it afterwards
+        /// </summary>
+        public void Enqueue(NativeHandleType type, IntPtr handle)
+        {
+            if (IntPtr.Zero == handle)
+                return;
+
+            lock (sync)
+            {
+                if (count == types.Length)
+                {
+                    Array.Resize(ref types, count * 2);
+                    Array.Resize(ref objects, count * 2);
+                }
+
+                types[count] = (int)type;
+                objects[count] = handle;
+                ++count;
+            }
+        }
+
+        /// <summary>
+        /// Detaches native object from the wrapper (Mat or any VectorOf*) and queues it for release,
+        /// the wrapper is disposed immediately
+        /// </summary>
+        public void Enqueue(DisposableCvObject obj)
+        {
+            if (null == obj)
+                throw new ArgumentNullException("obj");
+            if (obj.IsDisposed)
+                return;
+
+            NativeHandleType type = NativeHandleType.Mat;
+            if (!obj.IsEnabledDispose || !(obj is Mat || wrapperTypes.TryGetValue(obj.GetType(), out type)))
+            {
+                // not owned or not supported, regular path
+                obj.Dispose();
+                return;
+            }
+
+            Enqueue(type, obj.CvPtr);
+            obj.IsEnabledDispose = false;
+            obj.Dispose();
+        }
+
+        /// <summary>
+        /// Releases all queued objects with a single native call
+        /// </summary>
+        /// <returns>Number of objects released</returns>
+        public int Flush()
+        {
+            lock (sync)
+            {
+                if (0 == count)
+                    return 0;
+
+                int released = NativeMethods.core_releaseBatch(types, objects, count);
+                Array.Clear(objects, 0, count);
+                count = 0;
+                return released;
+            }
+        }
+    }
+}
@@ -0,0 +1,262 @@
+﻿using System;
+using System.Runtime.InteropServices;
+
+namespace OpenCvSharp
+{
+    /// <summary>
+    /// Single face detection, native objdetect_CascadeDetection layout
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct CascadeDetection
+    {
+        /// <summary>
+        /// Face rect
+        /// </summary>
+        public Rect Face;
+
+        /// <summary>
+        /// Left-most eye, valid if EyesCount &gt; 0
+        /// </summary>
+        public Rect LeftEye;
+
+        /// <summary>
+        /// Right-most eye, valid if EyesCount &gt; 1
+        /// </summary>
+        public Rect RightEye;
+
+        /// <summary>
+        /// Number of eyes found inside the face rect
+        /// </summary>
+        public int EyesCount;
+
+        private int confirmed;
+
+        /// <summary>
+        /// True if face is confirmed by the eyes pass (or there is no eyes cascade)
+        /// </summary>
+        public bool Confirmed
+        {
+            get { return confirmed != 0; }
+        }
+    }
+
+    /// <summary>
+    /// Faces detector confirming faces with eyes. Owns several copies of each cascade and processes
+    /// detected faces in parallel
+    /// </summary>
+    public class CascadeDetector : DisposableCvObject
+    {
+        /// <summary>
+        /// Track whether Dispose has been called
+        /// </summary>
+        private bool disposed;
+
+        #region Init and Disposal
+
+        /// <summary>
+        /// Creates detector
+        /// </summary>
+        /// <param name="threads">Number of cascade copies, i.e. max faces processed in parallel, 0 to match OpenCV threads number</param>
+        public CascadeDetector(int threads = 0)
+        {
+            ptr = NativeMethods.objdetect_CascadeDetector_new(threads);
+        }
+
+        /// <summary>
+        /// Clean up any resources being used.
+        /// </summary>
+        /// <param name="disposing">
+        /// If disposing equals true, the method has been called directly or indirectly by a user's code. Managed and unmanaged resources can be disposed.
+        /// If false, the method has been called by the runtime from inside the finalizer and you should not reference other objects. Only unmanaged resources can be disposed.
+        /// </param>
+        protected override void Dispose(bool disposing)
+        {
+            if (!disposed)
+            {
+                try
+                {
+                    if (IsEnabledDispose)
+                    {
+                        NativeMethods.objdetect_CascadeDetector_delete(ptr);
+                    }
+                    disposed = true;
+                }
+                finally
+                {
+                    base.Dispose(disposing);
+                }
+            }
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Number of cascade copies
+        /// </summary>
+        public int Threads
+        {
+            get
+            {
+                ThrowIfDisposed();
+                return NativeMethods.objdetect_CascadeDetector_getThreads(ptr);
+            }
+        }
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Loads face cascade from XML node (in-memory loading)
+        /// </summary>
+        /// <returns>True for success, false otherwise</returns>
+        public bool ReadFaceCascade(FileNode node)
+        {
+            ThrowIfDisposed();
+            if (null == node)
+                throw new ArgumentNullException("node");
+            return NativeMethods.objdetect_CascadeDetector_readFaceCascade(ptr, node.CvPtr) != 0;
+        }
+
+        /// <summary>
+        /// Loads face cascade from file
+        /// </summary>
+        /// <returns>True for success, false otherwise</returns>
+        public bool LoadFaceCascade(string fileName)
+        {
+            ThrowIfDisposed();
+            if (String.IsNullOrEmpty(fileName))
+                throw new ArgumentNullException("fileName");
+            return NativeMethods.objdetect_CascadeDetector_loadFaceCascade(ptr, fileName) != 0;
+        }
+
+        /// <summary>
+        /// Loads eyes cascade from XML node (in-memory loading), faces are not confirmed while there is no eyes cascade
+        /// </summary>
+        /// <returns>True for success, false otherwise</returns>
+        public bool ReadEyesCascade(FileNode node)
+        {
+            ThrowIfDisposed();
+            if (null == node)
+                throw new ArgumentNullException("node");
+            return NativeMethods.objdetect_CascadeDetector_readEyesCascade(ptr, node.CvPtr) != 0;
+        }
+
+        /// <summary>
+        /// Loads eyes cascade from file
+        /// </summary>
+        /// <returns>True for success, false otherwise</returns>
+        public bool LoadEyesCascade(string fileName)
+        {
+            ThrowIfDisposed();
+            if (String.IsNullOrEmpty(fileName))
+                throw new ArgumentNullException("fileName");
+            return NativeMethods.objdetect_CascadeDetector_loadEyesCascade(ptr, fileName) != 0;
+        }
+
+        /// <summary>
+        /// Sets face detection parameters, see CascadeClassifier.DetectMultiScale
+        /// </summary>
+        public void SetFaceParams(double scaleFactor = 1.2, int minNeighbors = 6, Size? minSize = null, Size? maxSize = null)
+        {
+            ThrowIfDisposed();
+            NativeMethods.objdetect_CascadeDetector_setFaceParams(ptr, scaleFactor, minNeighbors, minSize.GetValueOrDefault(new Size()), maxSize.GetValueOrDefault(new Size()));
+        }
+
+        /// <summary>
+        /// Sets eyes confirmation parameters, face is confirmed if number of eyes found is within [minEyes, maxEyes]
+        /// </summary>
+        /// <param name="rejectUnconfirmed">True to drop unconfirmed faces from the results</param>
+        public void SetEyesParams(double scaleFactor = 1.1, int minNeighbors = 3, Size? minSize = null, int minEyes = 1, int maxEyes = 2, bool rejectUnconfirmed = true)
+        {
+            ThrowIfDisposed();
+            NativeMethods.objdetect_CascadeDetector_setEyesParams(ptr, scaleFactor, minNeighbors, minSize.GetValueOrDefault(new Size()), minEyes, maxEyes, rejectUnconfirmed ? 1 : 0);
+        }
+
+        /// <summary>
+        /// Detects faces and confirms them with eyes
+        /// </summary>
+        /// <param name="image">8-bit grayscale image</param>
+        /// <returns>Detected faces</returns>
+        public CascadeDetection[] Detect(Mat image)
+        {
+            ThrowIfDisposed();
+            if (null == image)
+                throw new ArgumentNullException("image");
+            image.ThrowIfDisposed();
+
+            IntPtr results;
+            int count = NativeMethods.objdetect_CascadeDetector_detect(ptr, image.CvPtr, out results);
+            return ToArray(results, count);
+        }
+
+        /// <summary>
+        /// Sets tracking mode parameters
+        /// </summary>
+        /// <param name="rescanInterval">Full frame is scanned every rescanInterval frames, 1 to scan every frame</param>
+        /// <param name="roiExpand">Search ROI is the previous face rect expanded by roiExpand of its size at every side</param>
+        /// <param name="scaleBand">Searched face sizes are within [previous / scaleBand, previous * scaleBand]</param>
+        public void SetTrackingParams(int rescanInterval = 10, double roiExpand = 0.5, double scaleBand = 1.25)
+        {
+            ThrowIfDisposed();
+            NativeMethods.objdetect_CascadeDetector_setTrackingParams(ptr, rescanInterval, roiExpand, scaleBand);
+        }
+
+        /// <summary>
+        /// Detects faces searching only around the previous frame faces, the whole frame is scanned periodically
+        /// or once any face is lost
+        /// </summary>
+        /// <param name="image">8-bit grayscale image</param>
+        /// <param name="fullScan">True if the whole frame has been scanned</param>
+        /// <returns>Detected faces</returns>
+        public CascadeDetection[] Track(Mat image, out bool fullScan)
+        {
+            ThrowIfDisposed();
+            if (null == image)
+                throw new ArgumentNullException("image");
+            image.ThrowIfDisposed();
+
+            IntPtr results;
+            int scanned;
+            int count = NativeMethods.objdetect_CascadeDetector_track(ptr, image.CvPtr, out results, out scanned);
+            fullScan = scanned != 0;
+            return ToArray(results, count);
+        }
+
+        /// <summary>
+        /// Detects faces searching only around the previous frame faces
+        /// </summary>
+        /// <param name="image">8-bit grayscale image</param>
+        /// <returns>Detected faces</returns>
+        public CascadeDetection[] Track(Mat image)
+        {
+            bool fullScan;
+            return Track(image, out fullScan);
+        }
+
+        /// <summary>
+        /// Forgets tracked faces, the next Track call scans the whole frame
+        /// </summary>
+        public void ResetTracking()
+        {
+            ThrowIfDisposed();
+            NativeMethods.objdetect_CascadeDetector_resetTracking(ptr);
+        }
+
+        /// <summary>
+        /// Copies native detections array
+        /// </summary>
+        protected static CascadeDetection[] ToArray(IntPtr results, int count)
+        {
+            CascadeDetection[] ret = new CascadeDetection[count];
+            int size = Marshal.SizeOf(typeof(CascadeDetection));
+            for (int i = 0; i < count; ++i)
+                ret[i] = (CascadeDetection)Marshal.PtrToStructure(new IntPtr(results.ToInt64() + i * size), typeof(CascadeDetection));
+            return ret;
+        }
+
+        #endregion
+    }
+}
@@ -0,0 +1,163 @@
+﻿using System;
+using System.Runtime.InteropServices;
+
+namespace OpenCvSharp.Tracking
+{
+    /// <summary>
+    /// Single track state, native tracking_TrackedObject layout
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct TrackedObject
+    {
+        /// <summary>
+        /// Track id, as returned by MultiObjectTracker.Add
+        /// </summary>
+        public int Id;
+
+        private int ok;
+
+        /// <summary>
+        /// Track bounding box, the last known one if the update has failed
+        /// </summary>
+        public Rect2d Rect;
+
+        /// <summary>
+        /// False if tracker has failed to locate the target, the track is dropped then
+        /// </summary>
+        public bool Ok
+        {
+            get { return ok != 0; }
+        }
+    }
+
+    /// <summary>
+    /// Set of trackers (of any types) updated against the same frame in parallel within a single native call
+    /// </summary>
+    public class MultiObjectTracker : DisposableCvObject
+    {
+        /// <summary>
+        /// Track whether Dispose has been called
+        /// </summary>
+        private bool disposed;
+
+        #region Init and Disposal
+
+        /// <summary>
+        /// Creates empty tracker
+        /// </summary>
+        public MultiObjectTracker()
+        {
+            ptr = NativeMethods.tracking_MultiObjectTracker_new();
+        }
+
+        /// <summary>
+        /// Clean up any resources being used.
+        /// </summary>
+        /// <param name="disposing">
+        /// If disposing equals true, the method has been called directly or indirectly by a user's code. Managed and unmanaged resources can be disposed.
+        /// If false, the method has been called by the runtime from inside the finalizer and you should not reference other objects. Only unmanaged resources can be disposed.
+        /// </param>
+        protected override void Dispose(bool disposing)
+        {
+            if (!disposed)
+            {
+                try
+                {
+                    if (IsEnabledDispose)
+                    {
+                        NativeMethods.tracking_MultiObjectTracker_delete(ptr);
+                    }
+                    disposed = true;
+                }
+                finally
+                {
+                    base.Dispose(disposing);
+                }
+            }
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Number of live tracks
+        /// </summary>
+        public int Count
+        {
+            get
+            {
+                ThrowIfDisposed();
+                return NativeMethods.tracking_MultiObjectTracker_size(ptr);
+            }
+        }
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Creates new track
+        /// </summary>
+        /// <param name="trackerType">Tracker type</param>
+        /// <param name="image">The initial frame</param>
+        /// <param name="boundingBox">The initial bounding box</param>
+        /// <returns>Track id, -1 if tracker has failed to initialize</returns>
+        public int Add(TrackerTypes trackerType, Mat image, Rect2d boundingBox)
+        {
+            ThrowIfDisposed();
+            if (image == null)
+                throw new ArgumentNullException("image");
+            image.ThrowIfDisposed();
+
+            int id = NativeMethods.tracking_MultiObjectTracker_add(ptr, Tracker.TypeName(trackerType), image.CvPtr, boundingBox);
+            GC.KeepAlive(image);
+            return id;
+        }
+
+        /// <summary>
+        /// Removes track
+        /// </summary>
+        /// <returns>False if there is no such track</returns>
+        public bool Remove(int id)
+        {
+            ThrowIfDisposed();
+            return NativeMethods.tracking_MultiObjectTracker_remove(ptr, id) != 0;
+        }
+
+        /// <summary>
+        /// Removes all tracks
+        /// </summary>
+        public void Clear()
+        {
+            ThrowIfDisposed();
+            NativeMethods.tracking_MultiObjectTracker_clear(ptr);
+        }
+
+        /// <summary>
+        /// Updates all tracks against the frame in parallel. Tracks failed to update are reported with Ok
+        /// set to false and dropped
+        /// </summary>
+        /// <param name="image">The current frame</param>
+        /// <returns>Tracks state</returns>
+        public TrackedObject[] Update(Mat image)
+        {
+            ThrowIfDisposed();
+            if (image == null)
+                throw new ArgumentNullException("image");
+            image.ThrowIfDisposed();
+
+            IntPtr results;
+            int count = NativeMethods.tracking_MultiObjectTracker_update(ptr, image.CvPtr, out results);
+            GC.KeepAlive(image);
+
+            TrackedObject[] ret = new TrackedObject[count];
+            int size = Marshal.SizeOf(typeof(TrackedObject));
+            for (int i = 0; i < count; ++i)
+                ret[i] = (TrackedObject)Marshal.PtrToStructure(new IntPtr(results.ToInt64() + i * size), typeof(TrackedObject));
+            return ret;
+        }
+
+        #endregion
+    }
+}
@@ -27,32 +27,32 @@
         /// <param name="trackerType"></param>
         public static Tracker Create(TrackerTypes trackerType)
         {
-            IntPtr ptr;
+            IntPtr ptr = NativeMethods.tracking_Tracker_create(TypeName(trackerType));
+            return new Tracker(ptr);
+        }
+
+        /// <summary>
+        /// Native tracker type name, as cv::Tracker::create expects it
+        /// </summary>
+        internal static string TypeName(TrackerTypes trackerType)
+        {
             switch (trackerType)
             {
                 case TrackerTypes.Boosting:
-                    ptr = NativeMethods.tracking_Tracker_create("BOOSTING");
-                    break;
+                    return "BOOSTING";
                 case TrackerTypes.GOTURN:
-                    ptr = NativeMethods.tracking_Tracker_create("GOTURN");
-                    break;
+                    return "GOTURN";
                 case TrackerTypes.TLD:
-                    ptr = NativeMethods.tracking_Tracker_create("TLD");
-                    break;
+                    return "TLD";
                 case TrackerTypes.KCF:
-                    ptr = NativeMethods.tracking_Tracker_create("KCF");
-                    break;
+                    return "KCF";
                 case TrackerTypes.MedianFlow:
-                    ptr = NativeMethods.tracking_Tracker_create("MEDIANFLOW");
-                    break;
+                    return "MEDIANFLOW";
                 case TrackerTypes.MIL:
-                    ptr = NativeMethods.tracking_Tracker_create("MIL");
-                    break;
+                    return "MIL";
                 default:
                     throw new ArgumentOutOfRangeException(trackerType.ToString(), trackerType, null);
             }
-
-            return new Tracker(ptr);
         }
 
         /// <summary>
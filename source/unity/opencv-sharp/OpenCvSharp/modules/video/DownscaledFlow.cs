@@ -0,0 +1,178 @@
+﻿using System;
+using System.Runtime.InteropServices;
+
+namespace OpenCvSharp
+{
+    /// <summary>
+    /// DownscaledFlow stages time, milliseconds, native video_DenseFlowTimings layout
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct DenseFlowTimings
+    {
+        /// <summary>
+        /// Grayscale conversion and pyramid reduction
+        /// </summary>
+        public double Downscale;
+
+        /// <summary>
+        /// Flow at the reduced resolution
+        /// </summary>
+        public double Flow;
+
+        /// <summary>
+        /// Upsampling to the full resolution
+        /// </summary>
+        public double Upsample;
+
+        /// <summary>
+        /// Whole call
+        /// </summary>
+        public double Total;
+    }
+
+    /// <summary>
+    /// Dense optical flow computed at a reduced pyramid level and upsampled (with vectors rescaled) back to the
+    /// full resolution. Keeps the previous frame, so it's fed with consecutive video frames
+    /// </summary>
+    public class DownscaledFlow : DisposableCvObject
+    {
+        private bool disposed;
+        private DenseOpticalFlow algorithm;
+
+        #region Init & Disposal
+
+        /// <summary>
+        /// Creates Farneback flow computed at the given pyramid level
+        /// </summary>
+        /// <param name="level">pyramid level, each one halves the frame size; 0 is the full resolution</param>
+        public DownscaledFlow(int level = 2)
+        {
+            ptr = NativeMethods.video_DownscaledFlow_new();
+            NativeMethods.video_DownscaledFlow_setLevel(ptr, level);
+        }
+
+        /// <summary>
+        /// Clean up any resources being used.
+        /// </summary>
+        /// <param name="disposing">
+        /// If disposing equals true, the method has been called directly or indirectly by a user's code. Managed and unmanaged resources can be disposed.
+        /// If false, the method has been called by the runtime from inside the finalizer and you should not reference other objects. Only unmanaged resources can be disposed.
+        /// </param>
+        protected override void Dispose(bool disposing)
+        {
+            if (!disposed)
+            {
+                try
+                {
+                    if (IsEnabledDispose)
+                    {
+                        NativeMethods.video_DownscaledFlow_delete(ptr);
+                    }
+                    algorithm = null;
+                    disposed = true;
+                }
+                finally
+                {
+                    base.Dispose(disposing);
+                }
+            }
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Pyramid level flow is computed at, changing it drops the previous frame
+        /// </summary>
+        public int Level
+        {
+            get
+            {
+                ThrowIfDisposed();
+                return NativeMethods.video_DownscaledFlow_getLevel(ptr);
+            }
+            set
+            {
+                ThrowIfDisposed();
+                NativeMethods.video_DownscaledFlow_setLevel(ptr, value);
+            }
+        }
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Switches to Farneback, parameters are the same as for Cv2.CalcOpticalFlowFarneback
+        /// </summary>
+        public void SetFarneback(double pyrScale = 0.5, int levels = 3, int winSize = 15, int iterations = 3,
+            int polyN = 5, double polySigma = 1.2, OpticalFlowFlags flags = OpticalFlowFlags.None)
+        {
+            ThrowIfDisposed();
+            NativeMethods.video_DownscaledFlow_setFarneback(ptr, pyrScale, levels, winSize, iterations, polyN, polySigma, (int)flags);
+            algorithm = null;
+        }
+
+        /// <summary>
+        /// Switches to custom algorithm, i.e. DenseOpticalFlow.CreateOptFlow_DualTVL1(); it's referenced until switched again
+        /// </summary>
+        public void SetAlgorithm(DenseOpticalFlow flow)
+        {
+            ThrowIfDisposed();
+            if (flow == null)
+                throw new ArgumentNullException("flow");
+            flow.ThrowIfDisposed();
+
+            NativeMethods.video_DownscaledFlow_setAlgorithm(ptr, flow.CvPtr);
+            algorithm = flow;
+        }
+
+        /// <summary>
+        /// Computes full resolution flow between the previous frame and the given one
+        /// </summary>
+        /// <param name="image">8-bit grayscale, BGR or BGRA frame</param>
+        /// <param name="flow">receives full resolution CV_32FC2 flow</param>
+        /// <param name="timings">stages time of this call</param>
+        /// <returns>False if there was no previous frame (the given one just gets stored), flow is untouched then</returns>
+        public bool Process(Mat image, Mat flow, out DenseFlowTimings timings)
+        {
+            ThrowIfDisposed();
+            if (image == null)
+                throw new ArgumentNullException("image");
+            if (flow == null)
+                throw new ArgumentNullException("flow");
+            image.ThrowIfDisposed();
+            flow.ThrowIfDisposed();
+            if (algorithm != null)
+                algorithm.ThrowIfDisposed();
+
+            int ret = NativeMethods.video_DownscaledFlow_process(ptr, image.CvPtr, flow.CvPtr, out timings);
+            GC.KeepAlive(image);
+            GC.KeepAlive(flow);
+            GC.KeepAlive(algorithm);
+            return ret != 0;
+        }
+
+        /// <summary>
+        /// Computes full resolution flow between the previous frame and the given one
+        /// </summary>
+        /// <returns>False if there was no previous frame (the given one just gets stored), flow is untouched then</returns>
+        public bool Process(Mat image, Mat flow)
+        {
+            DenseFlowTimings timings;
+            return Process(image, flow, out timings);
+        }
+
+        /// <summary>
+        /// Drops the previous frame
+        /// </summary>
+        public void Reset()
+        {
+            ThrowIfDisposed();
+            NativeMethods.video_DownscaledFlow_reset(ptr);
+        }
+
+        #endregion
+    }
+}
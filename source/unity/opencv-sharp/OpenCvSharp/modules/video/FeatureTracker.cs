@@ -0,0 +1,205 @@
+﻿using System;
+using System.Runtime.InteropServices;
+
+namespace OpenCvSharp
+{
+    /// <summary>
+    /// Corners detector used by FeatureTracker to seed the grid
+    /// </summary>
+    public enum FeatureDetectorType
+    {
+        /// <summary>
+        /// Cv2.GoodFeaturesToTrack
+        /// </summary>
+        GoodFeaturesToTrack = 0,
+
+        /// <summary>
+        /// Cv2.FAST
+        /// </summary>
+        Fast = 1,
+    }
+
+    /// <summary>
+    /// TrackedFeature state
+    /// </summary>
+    public enum FeatureStatus
+    {
+        /// <summary>
+        /// Failed to track or the forward-backward check, reported once and dropped
+        /// </summary>
+        Lost = 0,
+
+        /// <summary>
+        /// Tracked from the previous frame
+        /// </summary>
+        Tracked = 1,
+
+        /// <summary>
+        /// Detected on this frame
+        /// </summary>
+        Seeded = 2,
+    }
+
+    /// <summary>
+    /// Single feature state, native video_TrackedFeature layout
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct TrackedFeature
+    {
+        /// <summary>
+        /// Feature id, unique within the tracker
+        /// </summary>
+        public int Id;
+
+        /// <summary>
+        /// Feature position, the last known one for lost features
+        /// </summary>
+        public Point2f Point;
+
+        /// <summary>
+        /// Feature state
+        /// </summary>
+        public FeatureStatus Status;
+
+        /// <summary>
+        /// Frames tracked since seeding
+        /// </summary>
+        public int Age;
+    }
+
+    /// <summary>
+    /// Native KLT engine: corners are seeded in the cells of a grid, tracked with pyramidal Lucas-Kanade and
+    /// validated by the forward-backward check. Empty cells are re-seeded once grid coverage drops
+    /// </summary>
+    public class FeatureTracker : DisposableCvObject
+    {
+        private bool disposed;
+
+        #region Init & Disposal
+
+        /// <summary>
+        /// Creates tracker with 8x6 grid, 4 corners per cell, GoodFeaturesToTrack seeding
+        /// </summary>
+        /// <param name="winSize">size of the LK search window at each pyramid level</param>
+        /// <param name="maxLevel">LK 0-based maximal pyramid level number</param>
+        public FeatureTracker(Size? winSize = null, int maxLevel = 3)
+        {
+            ptr = NativeMethods.video_FeatureTracker_new(winSize.GetValueOrDefault(new Size(21, 21)), maxLevel);
+        }
+
+        /// <summary>
+        /// Clean up any resources being used.
+        /// </summary>
+        /// <param name="disposing">
+        /// If disposing equals true, the method has been called directly or indirectly by a user's code. Managed and unmanaged resources can be disposed.
+        /// If false, the method has been called by the runtime from inside the finalizer and you should not reference other objects. Only unmanaged resources can be disposed.
+        /// </param>
+        protected override void Dispose(bool disposing)
+        {
+            if (!disposed)
+            {
+                try
+                {
+                    if (IsEnabledDispose)
+                    {
+                        NativeMethods.video_FeatureTracker_delete(ptr);
+                    }
+                    disposed = true;
+                }
+                finally
+                {
+                    base.Dispose(disposing);
+                }
+            }
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Maximum number of features Process might report, output buffer of this size fits them all
+        /// </summary>
+        public int Capacity
+        {
+            get
+            {
+                ThrowIfDisposed();
+                return NativeMethods.video_FeatureTracker_capacity(ptr);
+            }
+        }
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Sets seeding grid, drops all the features
+        /// </summary>
+        /// <param name="cols">grid columns</param>
+        /// <param name="rows">grid rows</param>
+        /// <param name="maxPerCell">maximum number of corners seeded per cell</param>
+        public void SetGrid(int cols, int rows, int maxPerCell)
+        {
+            ThrowIfDisposed();
+            NativeMethods.video_FeatureTracker_setGrid(ptr, cols, rows, maxPerCell);
+        }
+
+        /// <summary>
+        /// Sets corners detector
+        /// </summary>
+        /// <param name="detector">detector type</param>
+        /// <param name="qualityLevel">GoodFeaturesToTrack quality level</param>
+        /// <param name="minDistance">GoodFeaturesToTrack minimum distance between corners</param>
+        /// <param name="fastThreshold">FAST threshold</param>
+        public void SetDetector(FeatureDetectorType detector, double qualityLevel = 0.01, double minDistance = 8, int fastThreshold = 20)
+        {
+            ThrowIfDisposed();
+            NativeMethods.video_FeatureTracker_setDetector(ptr, (int)detector, qualityLevel, minDistance, fastThreshold);
+        }
+
+        /// <summary>
+        /// Sets tracking parameters
+        /// </summary>
+        /// <param name="criteria">LK termination criteria</param>
+        /// <param name="minEigThreshold">LK minimum eigen value threshold</param>
+        /// <param name="fbThreshold">maximum forward-backward error, pixels</param>
+        /// <param name="minCoverage">share of occupied grid cells [0, 1] below which empty cells are re-seeded</param>
+        public void SetTracking(TermCriteria criteria, float minEigThreshold = 1e-4f, float fbThreshold = 1f, float minCoverage = 0.7f)
+        {
+            ThrowIfDisposed();
+            NativeMethods.video_FeatureTracker_setTracking(ptr, criteria, minEigThreshold, fbThreshold, minCoverage);
+        }
+
+        /// <summary>
+        /// Tracks features to the frame and re-seeds the grid if required, writing them into the pre-allocated buffer
+        /// </summary>
+        /// <param name="image">8-bit grayscale, BGR or BGRA frame</param>
+        /// <param name="output">features buffer, Capacity items fit all of them</param>
+        /// <returns>Number of features (including the ones lost on this frame), only the first output.Length of them are written</returns>
+        public int Process(Mat image, TrackedFeature[] output)
+        {
+            ThrowIfDisposed();
+            if (image == null)
+                throw new ArgumentNullException("image");
+            if (output == null)
+                throw new ArgumentNullException("output");
+            image.ThrowIfDisposed();
+
+            int count = NativeMethods.video_FeatureTracker_process(ptr, image.CvPtr, output, output.Length);
+            GC.KeepAlive(image);
+            return count;
+        }
+
+        /// <summary>
+        /// Drops the previous frame and all the features
+        /// </summary>
+        public void Reset()
+        {
+            ThrowIfDisposed();
+            NativeMethods.video_FeatureTracker_reset(ptr);
+        }
+
+        #endregion
+    }
+}
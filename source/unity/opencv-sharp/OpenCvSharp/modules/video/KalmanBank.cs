@@ -0,0 +1,125 @@
+﻿using System;
+
+namespace OpenCvSharp
+{
+    /// <summary>
+    /// Bank of independent constant-velocity Kalman filters over scalar values (i.e. landmark coordinates, x and y
+    /// are separate values) sharing a single model. All filters are processed within one native call
+    /// </summary>
+    public class KalmanBank : DisposableCvObject
+    {
+        private bool disposed;
+
+        #region Init & Disposal
+
+        /// <summary>
+        /// Creates bank, filters are initialized by the first Process call
+        /// </summary>
+        /// <param name="count">Number of filters</param>
+        public KalmanBank(int count)
+        {
+            if (count <= 0)
+                throw new ArgumentOutOfRangeException("count");
+            ptr = NativeMethods.video_KalmanBank_new(count);
+        }
+
+        /// <summary>
+        /// Clean up any resources being used.
+        /// </summary>
+        /// <param name="disposing">
+        /// If disposing equals true, the method has been called directly or indirectly by a user's code. Managed and unmanaged resources can be disposed.
+        /// If false, the method has been called by the runtime from inside the finalizer and you should not reference other objects. Only unmanaged resources can be disposed.
+        /// </param>
+        protected override void Dispose(bool disposing)
+        {
+            if (!disposed)
+            {
+                try
+                {
+                    if (IsEnabledDispose)
+                    {
+                        NativeMethods.video_KalmanBank_delete(ptr);
+                    }
+                    disposed = true;
+                }
+                finally
+                {
+                    base.Dispose(disposing);
+                }
+            }
+        }
+
+        #endregion
+
+        #region Properties
+
+        /// <summary>
+        /// Number of filters
+        /// </summary>
+        public int Count
+        {
+            get
+            {
+                ThrowIfDisposed();
+                return NativeMethods.video_KalmanBank_count(ptr);
+            }
+        }
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Sets the shared model parameters
+        /// </summary>
+        /// <param name="dt">Time step between measurements</param>
+        /// <param name="processNoise">Acceleration variance, the bigger it is the faster filters follow measurements</param>
+        /// <param name="measurementNoise">Measurement variance</param>
+        public void SetParams(float dt = 1.0f, float processNoise = 1e-2f, float measurementNoise = 1.0f)
+        {
+            ThrowIfDisposed();
+            NativeMethods.video_KalmanBank_setParams(ptr, dt, processNoise, measurementNoise);
+        }
+
+        /// <summary>
+        /// Re-initializes filters with the measurements, null to let the next Process call do that
+        /// </summary>
+        public void Reset(float[] measurements = null)
+        {
+            ThrowIfDisposed();
+            if (measurements != null && measurements.Length < Count)
+                throw new ArgumentException("measurements must contain Count values");
+            NativeMethods.video_KalmanBank_reset(ptr, measurements);
+        }
+
+        /// <summary>
+        /// Predict + correct step for every filter
+        /// </summary>
+        /// <param name="measurements">Count values, float.NaN for missing measurements (such filters are predicted only)</param>
+        /// <param name="output">Receives Count filtered values, might be the measurements array itself or null</param>
+        public void Process(float[] measurements, float[] output)
+        {
+            ThrowIfDisposed();
+            if (measurements == null)
+                throw new ArgumentNullException("measurements");
+            if (output != null && output.Length != measurements.Length)
+                throw new ArgumentException("output must be of the measurements length");
+
+            if (NativeMethods.video_KalmanBank_process(ptr, measurements, output, measurements.Length) == 0)
+                throw new ArgumentException("measurements must contain Count values");
+        }
+
+        /// <summary>
+        /// Copies filters velocities (value change per dt)
+        /// </summary>
+        public void GetVelocities(float[] output)
+        {
+            ThrowIfDisposed();
+            if (output == null || output.Length < Count)
+                throw new ArgumentException("output must fit Count values");
+            NativeMethods.video_KalmanBank_getVelocities(ptr, output);
+        }
+
+        #endregion
+    }
+}
@@ -0,0 +1,113 @@
+﻿using System;
+
+namespace OpenCvSharp
+{
+    /// <summary>
+    /// Sparse Lucas-Kanade tracker for continuous video. Keeps the previous frame pyramid, so every frame
+    /// pyramid is built once instead of twice as with Cv2.CalcOpticalFlowPyrLK
+    /// </summary>
+    public class SparseFlowTracker : DisposableCvObject
+    {
+        private bool disposed;
+
+        #region Init & Disposal
+
+        /// <summary>
+        /// Creates tracker, parameters are the same as for Cv2.CalcOpticalFlowPyrLK
+        /// </summary>
+        /// <param name="winSize">size of the search window at each pyramid level</param>
+        /// <param name="maxLevel">0-based maximal pyramid level number</param>
+        /// <param name="criteria">termination criteria of the iterative search algorithm, default is 30 iterations or 0.01 eps</param>
+        /// <param name="flags">operation flags, OpticalFlowFlags.UseInitialFlow makes nextPts initial estimations</param>
+        /// <param name="minEigThreshold">minimum eigen value threshold</param>
+        public SparseFlowTracker(Size? winSize = null, int maxLevel = 3, TermCriteria? criteria = null,
+            OpticalFlowFlags flags = OpticalFlowFlags.None, double minEigThreshold = 1e-4)
+        {
+            Size winSize0 = winSize.GetValueOrDefault(new Size(21, 21));
+            TermCriteria criteria0 = criteria.GetValueOrDefault(TermCriteria.Both(30, 0.01));
+            ptr = NativeMethods.video_SparseFlowTracker_new(winSize0, maxLevel, criteria0, (int)flags, minEigThreshold);
+        }
+
+        /// <summary>
+        /// Clean up any resources being used.
+        /// </summary>
+        /// <param name="disposing">
+        /// If disposing equals true, the method has been called directly or indirectly by a user's code. Managed and unmanaged resources can be disposed.
+        /// If false, the method has been called by the runtime from inside the finalizer and you should not reference other objects. Only unmanaged resources can be disposed.
+        /// </param>
+        protected override void Dispose(bool disposing)
+        {
+            if (!disposed)
+            {
+                try
+                {
+                    if (IsEnabledDispose)
+                    {
+                        NativeMethods.video_SparseFlowTracker_delete(ptr);
+                    }
+                    disposed = true;
+                }
+                finally
+                {
+                    base.Dispose(disposing);
+                }
+            }
+        }
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Changes tracking parameters, see constructor
+        /// </summary>
+        public void SetParams(TermCriteria criteria, OpticalFlowFlags flags, double minEigThreshold)
+        {
+            ThrowIfDisposed();
+            NativeMethods.video_SparseFlowTracker_setParams(ptr, criteria, (int)flags, minEigThreshold);
+        }
+
+        /// <summary>
+        /// Tracks points from the previous frame to the given one, which becomes the previous one afterwards
+        /// </summary>
+        /// <param name="image">8-bit grayscale, BGR or BGRA frame</param>
+        /// <param name="prevPts">points on the previous frame, might be null to just store the frame</param>
+        /// <param name="nextPts">receives tracked points, must fit prevPts.Length items</param>
+        /// <param name="status">receives 1 for tracked points and 0 otherwise, must fit prevPts.Length items</param>
+        /// <param name="err">optional, receives tracking errors</param>
+        /// <returns>Number of tracked points, -1 if there was no previous frame (the given one just gets stored)</returns>
+        public int Track(Mat image, Point2f[] prevPts, Point2f[] nextPts, byte[] status, float[] err = null)
+        {
+            ThrowIfDisposed();
+            if (image == null)
+                throw new ArgumentNullException("image");
+            image.ThrowIfDisposed();
+
+            int count = (prevPts == null) ? 0 : prevPts.Length;
+            if (count > 0)
+            {
+                if (nextPts == null || nextPts.Length < count)
+                    throw new ArgumentException("nextPts must fit prevPts.Length items");
+                if (status == null || status.Length < count)
+                    throw new ArgumentException("status must fit prevPts.Length items");
+                if (err != null && err.Length < count)
+                    throw new ArgumentException("err must fit prevPts.Length items");
+            }
+
+            int ret = NativeMethods.video_SparseFlowTracker_track(ptr, image.CvPtr, prevPts, count, nextPts, status, err);
+            GC.KeepAlive(image);
+            return ret;
+        }
+
+        /// <summary>
+        /// Drops the previous frame, the next Track call just stores its frame
+        /// </summary>
+        public void Reset()
+        {
+            ThrowIfDisposed();
+            NativeMethods.video_SparseFlowTracker_reset(ptr);
+        }
+
+        #endregion
+    }
+}